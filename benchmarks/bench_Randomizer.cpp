@@ -0,0 +1,65 @@
+// Measures the piece generation speed of the randomizer policies,
+// both directly and through the runtime selectable interface.
+
+#include "game/components/randomizers/Randomizer.h"
+
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+
+namespace {
+constexpr unsigned piece_count = 100 * 1000 * 1000;
+
+template <typename Fn>
+void measure(const std::string& name, Fn&& fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const unsigned checksum = fn();
+    const auto end = std::chrono::steady_clock::now();
+
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::cout << std::left << std::setw(24) << name
+              << std::fixed << std::setprecision(2) << ns / piece_count << " ns/piece"
+              << "  (checksum " << checksum << ")\n";
+}
+
+template <typename Policy>
+void benchmark(const std::string& name, RandomizerType type)
+{
+    measure(name, [](){
+        Randomizers::Generator<Policy> generator(1);
+        unsigned checksum = 0;
+        for (unsigned i = 0; i < piece_count; i++)
+            checksum += static_cast<unsigned>(generator.next());
+        return checksum;
+    });
+
+    measure(name + " (runtime)", [type](){
+        auto randomizer = RandomizerFactory::make(type, 1);
+        std::array<PieceType, Randomizers::max_block_size> block;
+        unsigned checksum = 0;
+        unsigned generated = 0;
+        while (generated < piece_count) {
+            const unsigned count = randomizer->nextBlock(block.data());
+            for (unsigned i = 0; i < count; i++)
+                checksum += static_cast<unsigned>(block[i]);
+            generated += count;
+        }
+        return checksum;
+    });
+}
+} // namespace
+
+
+int main()
+{
+    benchmark<Randomizers::Bag7>("7-bag", RandomizerType::BAG7);
+    benchmark<Randomizers::Bag14>("14-bag", RandomizerType::BAG14);
+    benchmark<Randomizers::PureRandom>("pure random", RandomizerType::PURE_RANDOM);
+    benchmark<Randomizers::TGMHistory>("TGM history", RandomizerType::TGM_HISTORY);
+    benchmark<Randomizers::Bag7Plus1>("7+1 bag", RandomizerType::BAG7_PLUS1);
+    return 0;
+}
@@ -1,17 +1,27 @@
 #include "AppContext.h"
 
+#include "GameState.h"
+#include "trace/TraceRecorder.h"
 #include "system/Log.h"
 
 #include <cstdlib>
 #include <ctime>
 
 
-bool AppContext::init()
+AppContext::AppContext() = default;
+AppContext::~AppContext() = default;
+
+void AppContext::setTracer(std::unique_ptr<Trace::Recorder>&& tracer)
+{
+    m_tracer = std::move(tracer);
+}
+
+bool AppContext::init(bool headless)
 {
     const std::string log_tag = "init";
     try {
         Log::info(log_tag) << "Initializing video...\n";
-        m_window = Window::create();
+        m_window = headless ? Window::createHeadless(960, 540) : Window::create();
 
         std::srand(std::time(nullptr));
     }
@@ -11,11 +11,16 @@
 
 class AudioContext;
 class GameState;
+namespace Trace { class Recorder; }
 
 
 class AppContext {
 public:
-    bool init();
+    AppContext();
+    ~AppContext();
+
+    /// Create the game window; a headless one is drawn into memory only
+    bool init(bool headless = false);
 
     Window& window() { return *m_window; }
     GraphicsContext& gcx() { return m_window->graphicsContext(); }
@@ -25,6 +30,9 @@ public:
     ThemeConfig& theme() { return m_themeconfig; }
     WellConfig& wellconfig() { return m_wellconfig; }
     std::stack<std::unique_ptr<GameState>>& states() { return m_states; }
+    /// The event trace recorder, or nullptr if tracing is disabled
+    Trace::Recorder* tracer() { return m_tracer.get(); }
+    void setTracer(std::unique_ptr<Trace::Recorder>&&);
 
 private:
     std::unique_ptr<Window> m_window;
@@ -33,4 +41,5 @@ private:
     ThemeConfig m_themeconfig;
     WellConfig m_wellconfig;
     std::stack<std::unique_ptr<GameState>> m_states;
+    std::unique_ptr<Trace::Recorder> m_tracer;
 };
@@ -0,0 +1,89 @@
+#include "BattleTargeting.h"
+
+#include <assert.h>
+
+
+constexpr size_t BattleTargeting::no_target;
+
+BattleTargeting::BattleTargeting(TargetingType type, std::vector<size_t> teams_of_players, uint32_t seed)
+    : type(type)
+    , teams(std::move(teams_of_players))
+    , rng(seed)
+    , alive_index(teams.size())
+    , last_attacker(teams.size(), no_target)
+    , focus_target(no_target)
+{
+    alive.reserve(teams.size());
+    for (size_t slot = 0; slot < teams.size(); slot++) {
+        alive_index[slot] = alive.size();
+        alive.push_back(slot);
+    }
+}
+
+void BattleTargeting::removePlayer(size_t slot)
+{
+    assert(slot < teams.size());
+    const size_t idx = alive_index[slot];
+    if (idx == no_target)
+        return;
+
+    // swap with the last one, then remove
+    const size_t last_slot = alive.back();
+    alive[idx] = last_slot;
+    alive_index[last_slot] = idx;
+    alive.pop_back();
+    alive_index[slot] = no_target;
+
+    if (focus_target == slot)
+        focus_target = no_target;
+}
+
+bool BattleTargeting::isOpponent(size_t attacker, size_t target) const
+{
+    return target != no_target && isPlaying(target) && teams[target] != teams[attacker];
+}
+
+size_t BattleTargeting::randomOpponent(size_t attacker)
+{
+    if (alive.empty())
+        return no_target;
+
+    // in free-for-all games, this finds an opponent in the first few steps;
+    // in team games, the probing takes at most as many steps as there are players
+    const size_t start = std::uniform_int_distribution<size_t>(0, alive.size() - 1)(rng);
+    for (size_t step = 0; step < alive.size(); step++) {
+        const size_t candidate = alive[(start + step) % alive.size()];
+        if (teams[candidate] != teams[attacker])
+            return candidate;
+    }
+    return no_target;
+}
+
+size_t BattleTargeting::selectTarget(size_t attacker)
+{
+    assert(attacker < teams.size());
+
+    size_t target = no_target;
+    switch (type) {
+        case TargetingType::RANDOM:
+            break;
+        case TargetingType::ATTACKERS:
+            if (isOpponent(attacker, last_attacker[attacker]))
+                target = last_attacker[attacker];
+            break;
+        case TargetingType::KO_FOCUSED:
+            if (isOpponent(attacker, focus_target))
+                target = focus_target;
+            break;
+    }
+
+    if (target == no_target)
+        target = randomOpponent(attacker);
+
+    if (target != no_target) {
+        last_attacker[target] = attacker;
+        if (type == TargetingType::KO_FOCUSED && focus_target == no_target)
+            focus_target = target;
+    }
+    return target;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "TargetingType.h"
+
+#include <random>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+
+/// Chooses the targets of garbage attacks between the players of a battle.
+/// The players are identified by their slot, and every operation takes
+/// constant time (expected) regardless of the number of players.
+class BattleTargeting {
+public:
+    static constexpr size_t no_target = static_cast<size_t>(-1);
+
+    /// `teams` contains the team of every player slot
+    BattleTargeting(TargetingType, std::vector<size_t> teams, uint32_t seed);
+
+    /// Restart the random choices from the specified seed
+    void setSeed(uint32_t seed) { rng.seed(seed); }
+
+    /// Remove a player who is no longer playing
+    void removePlayer(size_t slot);
+    bool isPlaying(size_t slot) const { return alive_index[slot] != no_target; }
+    size_t playingCount() const { return alive.size(); }
+
+    /// Select the target of an attack, and remember the attacker.
+    /// Returns `no_target` if every remaining player is in the attacker's team.
+    size_t selectTarget(size_t attacker);
+
+private:
+    const TargetingType type;
+    const std::vector<size_t> teams;
+    std::mt19937 rng;
+
+    std::vector<size_t> alive; ///< the playing slots, in no particular order
+    std::vector<size_t> alive_index; ///< the position of every slot in `alive`, or `no_target`
+    std::vector<size_t> last_attacker; ///< per slot
+    size_t focus_target;
+
+    bool isOpponent(size_t attacker, size_t target) const;
+    size_t randomOpponent(size_t attacker);
+};
@@ -0,0 +1,124 @@
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <assert.h>
+
+
+constexpr Duration FramePacer::spin_margin;
+constexpr Duration FramePacer::latch_margin;
+
+FramePacer::Stats::Stats()
+    : count(0)
+    , mean(Duration::zero())
+    , jitter(Duration::zero())
+    , max(Duration::zero())
+    , late_frames(0)
+    , allocating_frames(0)
+    , max_allocations(0)
+    , mean_ns(0.0)
+    , m2_ns(0.0)
+{}
+
+void FramePacer::Stats::add(Duration interval, Duration target)
+{
+    // Welford's online algorithm
+    const double value_ns = std::chrono::duration<double, std::nano>(interval).count();
+    count++;
+    const double delta = value_ns - mean_ns;
+    mean_ns += delta / count;
+    m2_ns += delta * (value_ns - mean_ns);
+
+    mean = std::chrono::duration_cast<Duration>(std::chrono::duration<double, std::nano>(mean_ns));
+    jitter = std::chrono::duration_cast<Duration>(std::chrono::duration<double, std::nano>(
+        count > 1 ? std::sqrt(m2_ns / (count - 1)) : 0.0));
+    max = std::max(max, interval);
+    if (interval * 2 > target * 3)
+        late_frames++;
+}
+
+void FramePacer::Stats::addAllocations(uint64_t allocations)
+{
+    if (allocations)
+        allocating_frames++;
+    max_allocations = std::max(max_allocations, allocations);
+}
+
+FramePacer::FramePacer(FramePacing mode, Duration interval)
+    : m_mode(mode)
+    , m_interval(interval)
+    , frame_start(Clock::now())
+    , last_present(frame_start)
+    , timer_deadline(frame_start)
+    , presented(false)
+    , presented_previous(false)
+    , work_estimate(Duration::zero())
+{
+    assert(interval > Duration::zero());
+}
+
+void FramePacer::waitUntil(Clock::time_point deadline)
+{
+    if (Clock::now() + spin_margin < deadline)
+        std::this_thread::sleep_until(deadline - spin_margin);
+    while (Clock::now() < deadline)
+        std::this_thread::yield();
+}
+
+void FramePacer::waitForNextFrame()
+{
+    // with vsync, the presented frames follow the display instead of the timer
+    if (presented && m_mode != FramePacing::TIMER)
+        timer_deadline = last_present + m_interval;
+    else
+        timer_deadline += m_interval;
+
+    // resync only if the timer fell behind by more than an interval,
+    // otherwise the following frames catch up; it's never more than
+    // an interval ahead, so an idle frame never sleeps longer than that
+    const auto now = Clock::now();
+    if (timer_deadline + m_interval < now)
+        timer_deadline = now;
+    else if (timer_deadline > now + m_interval)
+        timer_deadline = now + m_interval;
+
+    if (!presented) {
+        // nothing was drawn, so the next frame doesn't need precise timing;
+        // sleeping through the whole interval lets the CPU idle
+        std::this_thread::sleep_until(timer_deadline);
+    }
+    else if (m_mode == FramePacing::VSYNC) {
+        // the present has already blocked until the blank; the short wait
+        // only limits the frame rate if the driver ignores the vsync request
+        waitUntil(frame_start + m_interval / 2);
+    }
+    else if (m_mode == FramePacing::VSYNC_LATE_LATCH) {
+        // start just early enough to make it to the next blank
+        waitUntil(last_present + m_interval - work_estimate - latch_margin);
+    }
+    else {
+        waitUntil(timer_deadline);
+    }
+
+    frame_start = Clock::now();
+    presented_previous = presented;
+    presented = false;
+}
+
+void FramePacer::markSubmit()
+{
+    const Duration work = Clock::now() - frame_start;
+    work_estimate = std::max(work, work_estimate - (work_estimate - work) / 16);
+}
+
+void FramePacer::markPresent()
+{
+    const auto now = Clock::now();
+    // intervals after skipped frames are intentional, not jitter
+    if (presented_previous)
+        m_stats.add(now - last_present, m_interval);
+
+    last_present = now;
+    presented = true;
+}
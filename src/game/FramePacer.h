@@ -0,0 +1,83 @@
+#pragma once
+
+#include "FramePacing.h"
+#include "Timing.h"
+
+#include <chrono>
+#include <stdint.h>
+
+
+/// Decides when the main loop should start its next frame,
+/// and measures the time between the presented frames.
+///
+/// A frame is expected to go through `waitForNextFrame()`, then the input
+/// handling and drawing, then `markSubmit()` right before presenting and
+/// `markPresent()` right after it. Frames that present nothing skip the marks.
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Present-to-present interval statistics
+    struct Stats {
+        unsigned long long count;
+        Duration mean;
+        Duration jitter; ///< the standard deviation of the intervals
+        Duration max;
+        unsigned long long late_frames; ///< intervals longer than 1.5 frames
+        unsigned long long allocating_frames; ///< frames that made heap allocations
+        uint64_t max_allocations; ///< the most heap allocations of a frame
+
+        Stats();
+        void add(Duration interval, Duration target);
+        void addAllocations(uint64_t count);
+
+    private:
+        double mean_ns;
+        double m2_ns;
+    };
+
+    FramePacer(FramePacing mode, Duration interval);
+
+    FramePacing mode() const { return m_mode; }
+    Duration interval() const { return m_interval; }
+
+    /// Block until the next frame should begin
+    void waitForNextFrame();
+    /// The frame is drawn and is about to be presented
+    void markSubmit();
+    /// The frame was presented
+    void markPresent();
+    /// The number of heap allocations the main thread made since the previous
+    /// presented frame; only counted in debug builds (see AllocationCounter)
+    void recordAllocations(uint64_t count) { m_stats.addAllocations(count); }
+
+    const Stats& stats() const { return m_stats; }
+
+    /// The time before a deadline when sleeping switches to busy waiting,
+    /// as sleeping may overshoot by up to a millisecond on common systems.
+    /// After a frame that presented nothing, the pacer only sleeps.
+    static constexpr Duration spin_margin = std::chrono::microseconds(1500);
+    /// The extra time left for the work of a late-latched frame
+    static constexpr Duration latch_margin = std::chrono::milliseconds(2);
+
+private:
+    const FramePacing m_mode;
+    const Duration m_interval;
+
+    Clock::time_point frame_start;
+    Clock::time_point last_present;
+    /// The start of the next frame when waiting for the full interval. The deadlines
+    /// are exactly one interval apart, so the wake-up delays don't accumulate.
+    /// It's kept within one interval of the current time.
+    Clock::time_point timer_deadline;
+    bool presented; ///< the current frame was presented
+    bool presented_previous;
+
+    /// The estimated time between the start of a frame and its submit,
+    /// which quickly follows the increases and slowly the decreases
+    Duration work_estimate;
+
+    Stats m_stats;
+
+    static void waitUntil(Clock::time_point);
+};
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <stdint.h>
+
+
+/// How the main loop waits between the frames
+enum class FramePacing : uint8_t {
+    VSYNC, ///< presenting a frame blocks until the vertical blank of the display
+    VSYNC_LATE_LATCH, ///< like VSYNC, but the input is read as late as possible before the next blank
+    TIMER, ///< no vsync, the frames are started by a precise timer
+};
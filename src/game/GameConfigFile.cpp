@@ -19,6 +19,7 @@ std::unordered_map<std::string, bool*> createBoolBind(SysConfig& sys) {
         {"fullscreen", &sys.fullscreen},
         {"sfx", &sys.sfx},
         {"music", &sys.music},
+        {"parallel_wells", &sys.parallel_wells},
     };
 }
 std::unordered_map<std::string, std::string*> createStringBind(SysConfig& sys) {
@@ -40,10 +41,52 @@ std::unordered_map<std::string, unsigned short*> createNumericBind(WellConfig& w
         {"das_repeat", &well.shift_turbo},
         {"lock_delay", &well.lock_delay},
         {"max_next_pieces", &well.max_next_pieces},
+        {"garbage_delay", &well.garbage_delay},
     };
 }
 
-const std::set<std::string> accepted_wellenum_keys = {"lock_type", "rotation"};
+// The keys of the custom scoring values, in the order of ScoreType
+const ScoreTypeArray<std::string> score_type_keys = {{{
+    "single", "double", "triple", "perfect",
+    "mini_tspin", "mini_tspin_single",
+    "tspin", "tspin_single", "tspin_double", "tspin_triple",
+    "softdrop", "harddrop", "combo",
+}}};
+
+std::unordered_map<std::string, bool*> createBoolBind(ScoreRules& rules) {
+    std::unordered_map<std::string, bool*> bind;
+    for (size_t i = 0; i < score_type_count; i++) {
+        const auto type = static_cast<ScoreType>(i);
+        bind.emplace(score_type_keys[type] + "_backtoback", &rules.continues_back2back[type]);
+    }
+    return bind;
+}
+std::unordered_map<std::string, unsigned short*> createNumericBind(ScoreRules& rules) {
+    std::unordered_map<std::string, unsigned short*> bind;
+    for (size_t i = 0; i < score_type_count; i++) {
+        const auto type = static_cast<ScoreType>(i);
+        bind.emplace(score_type_keys[type], &rules.score[type]);
+        bind.emplace(score_type_keys[type] + "_lines", &rules.line_awards[type]);
+    }
+    return bind;
+}
+std::unordered_map<std::string, unsigned char*> createByteBind(ScoreRules& rules) {
+    std::unordered_map<std::string, unsigned char*> bind;
+    for (size_t i = 0; i < score_type_count; i++) {
+        const auto type = static_cast<ScoreType>(i);
+        bind.emplace(score_type_keys[type] + "_attack", &rules.attack_lines[type]);
+    }
+    bind.emplace("backtoback_attack", &rules.back2back_attack_bonus);
+    return bind;
+}
+
+const std::unordered_map<std::string, FramePacing> str_to_pacing {
+    {"vsync", FramePacing::VSYNC},
+    {"latelatch", FramePacing::VSYNC_LATE_LATCH},
+    {"timer", FramePacing::TIMER},
+};
+
+const std::set<std::string> accepted_wellenum_keys = {"lock_type", "rotation", "randomizer", "targeting", "scoring"};
 const std::unordered_map<std::string, LockDelayType> str_to_locktype {
     {"instant", LockDelayType::CLASSIC},
     {"extended", LockDelayType::EXTENDED},
@@ -54,12 +97,43 @@ const std::unordered_map<std::string, RotationStyle> str_to_rotation {
     {"tgm", RotationStyle::TGM},
     {"classic", RotationStyle::CLASSIC},
 };
+const std::unordered_map<std::string, RandomizerType> str_to_randomizer {
+    {"bag", RandomizerType::BAG7},
+    {"doublebag", RandomizerType::BAG14},
+    {"random", RandomizerType::PURE_RANDOM},
+    {"history", RandomizerType::TGM_HISTORY},
+    {"bagplusone", RandomizerType::BAG7_PLUS1},
+};
+const std::unordered_map<std::string, TargetingType> str_to_targeting {
+    {"random", TargetingType::RANDOM},
+    {"attackers", TargetingType::ATTACKERS},
+    {"focus", TargetingType::KO_FOCUSED},
+};
+const std::unordered_map<std::string, ScoreRuleSet> str_to_scoring {
+    {"guideline", ScoreRuleSet::GUIDELINE},
+    {"classic", ScoreRuleSet::CLASSIC},
+    {"custom", ScoreRuleSet::CUSTOM},
+};
 
 const std::string boolAsStr(bool value)
 {
     return value ? "on" : "off";
 }
 
+unsigned long parseNumeric(const std::string& val_str, unsigned long max)
+{
+    try {
+        auto value = std::stoul(val_str);
+        if (value > max)
+            throw std::out_of_range("");
+
+        return value;
+    }
+    catch (...) {
+        throw std::runtime_error("Invalid numeric value '" + val_str + "', skipped");
+    }
+}
+
 void GameConfigFile::save(SysConfig& sys, WellConfig& well, const std::string& path)
 {
     std::ofstream out(path);
@@ -79,6 +153,12 @@ void GameConfigFile::save(SysConfig& sys, WellConfig& well, const std::string& p
         for (const auto& pair : sys_strings)
             sys_entries.emplace(pair.first, '"' + *pair.second + '"');
 
+        std::map<FramePacing, const std::string> pacing_to_str;
+        for (const auto& pair : str_to_pacing)
+            pacing_to_str.emplace(pair.second, pair.first);
+        assert(pacing_to_str.count(sys.frame_pacing));
+        sys_entries.emplace("frame_pacing", pacing_to_str.at(sys.frame_pacing));
+
         config.emplace("system", std::move(sys_entries));
     }
     {
@@ -103,8 +183,42 @@ void GameConfigFile::save(SysConfig& sys, WellConfig& well, const std::string& p
         assert(rotation_to_str.count(well.rotation_style));
         gameplay_entries.emplace("rotation", rotation_to_str.at(well.rotation_style));
 
+        std::map<RandomizerType, const std::string> randomizer_to_str;
+        for (const auto& pair : str_to_randomizer)
+            randomizer_to_str.emplace(pair.second, pair.first);
+        assert(randomizer_to_str.count(well.randomizer));
+        gameplay_entries.emplace("randomizer", randomizer_to_str.at(well.randomizer));
+
+        std::map<TargetingType, const std::string> targeting_to_str;
+        for (const auto& pair : str_to_targeting)
+            targeting_to_str.emplace(pair.second, pair.first);
+        assert(targeting_to_str.count(well.battle_targeting));
+        gameplay_entries.emplace("targeting", targeting_to_str.at(well.battle_targeting));
+
+        std::map<ScoreRuleSet, const std::string> scoring_to_str;
+        for (const auto& pair : str_to_scoring)
+            scoring_to_str.emplace(pair.second, pair.first);
+        assert(scoring_to_str.count(well.score_rules));
+        gameplay_entries.emplace("scoring", scoring_to_str.at(well.score_rules));
+
         config.emplace("gameplay", std::move(gameplay_entries));
     }
+    {
+        ConfigFile::KeyValPairs scoring_entries;
+        auto score_bools = createBoolBind(well.custom_score_rules);
+        for (const auto& pair : score_bools)
+            scoring_entries.emplace(pair.first, boolAsStr(*pair.second));
+
+        auto score_ushorts = createNumericBind(well.custom_score_rules);
+        for (const auto& pair : score_ushorts)
+            scoring_entries.emplace(pair.first, std::to_string(*pair.second));
+
+        auto score_bytes = createByteBind(well.custom_score_rules);
+        for (const auto& pair : score_bytes)
+            scoring_entries.emplace(pair.first, std::to_string(*pair.second));
+
+        config.emplace("scoring", std::move(scoring_entries));
+    }
     ConfigFile::save(config, path);
 }
 
@@ -114,8 +228,8 @@ std::tuple<SysConfig, WellConfig> GameConfigFile::load(const std::string& path)
     if (config.empty())
         return {};
 
-    const std::regex valid_value(R"(([0-9]{1,3}|on|off|yes|no|true|false|[a-z]+|".+?"))");
-    const std::set<std::string> accepted_headers = {"system", "gameplay"};
+    const std::regex valid_value(R"(([0-9]{1,5}|on|off|yes|no|true|false|[a-z]+|".+?"))");
+    const std::set<std::string> accepted_headers = {"system", "gameplay", "scoring"};
 
     SysConfig sys;
     WellConfig well;
@@ -124,6 +238,9 @@ std::tuple<SysConfig, WellConfig> GameConfigFile::load(const std::string& path)
     auto sys_strings = createStringBind(sys);
     auto well_bools = createBoolBind(well);
     auto well_ushorts = createNumericBind(well);
+    auto score_bools = createBoolBind(well.custom_score_rules);
+    auto score_ushorts = createNumericBind(well.custom_score_rules);
+    auto score_bytes = createByteBind(well.custom_score_rules);
 
     for (const auto& block : config) {
         const auto& block_name = block.first;
@@ -144,7 +261,17 @@ std::tuple<SysConfig, WellConfig> GameConfigFile::load(const std::string& path)
             }
 
             try {
-                if (sys_bools.count(key_str)) {
+                if (block_name == "scoring") {
+                    if (score_bools.count(key_str))
+                        *score_bools.at(key_str) = ConfigFile::parseBool(keyval);
+                    else if (score_ushorts.count(key_str))
+                        *score_ushorts.at(key_str) = parseNumeric(val_str, 0xFFFF);
+                    else if (score_bytes.count(key_str))
+                        *score_bytes.at(key_str) = parseNumeric(val_str, 0xFF);
+                    else
+                        throw std::runtime_error("Unknown scoring option '" + key_str + "', ignored");
+                }
+                else if (sys_bools.count(key_str)) {
                     *sys_bools.at(key_str) = ConfigFile::parseBool(keyval);
                 }
                 else if (sys_strings.count(key_str)) {
@@ -155,20 +282,17 @@ std::tuple<SysConfig, WellConfig> GameConfigFile::load(const std::string& path)
 
                     *sys_strings.at(key_str) = val_str.substr(1, val_str.size() - 2);
                 }
+                else if (key_str == "frame_pacing") {
+                    if (str_to_pacing.count(val_str))
+                        sys.frame_pacing = str_to_pacing.at(val_str);
+                    else
+                        throw std::runtime_error("Invalid frame pacing value '" + val_str + "', skipped");
+                }
                 else if (well_bools.count(key_str)) {
                     *well_bools.at(key_str) = ConfigFile::parseBool(keyval);
                 }
                 else if (well_ushorts.count(key_str)) {
-                    try {
-                        auto value = std::stoul(val_str);
-                        if (value > 0xFFFF)
-                            throw std::out_of_range("");
-
-                        *well_ushorts.at(key_str) = value;
-                    }
-                    catch (...) {
-                        throw std::runtime_error("Invalid numeric value '" + val_str + "', skipped");
-                    }
+                    *well_ushorts.at(key_str) = parseNumeric(val_str, 0xFFFF);
                 }
                 else if (accepted_wellenum_keys.count(key_str)) {
                     if (key_str == "lock_type") {
@@ -183,6 +307,24 @@ std::tuple<SysConfig, WellConfig> GameConfigFile::load(const std::string& path)
                         else
                             throw std::runtime_error("Invalid rotation style value '" + val_str + "', skipped");
                     }
+                    else if (key_str == "randomizer") {
+                        if (str_to_randomizer.count(val_str))
+                            well.randomizer = str_to_randomizer.at(val_str);
+                        else
+                            throw std::runtime_error("Invalid randomizer value '" + val_str + "', skipped");
+                    }
+                    else if (key_str == "targeting") {
+                        if (str_to_targeting.count(val_str))
+                            well.battle_targeting = str_to_targeting.at(val_str);
+                        else
+                            throw std::runtime_error("Invalid targeting value '" + val_str + "', skipped");
+                    }
+                    else if (key_str == "scoring") {
+                        if (str_to_scoring.count(val_str))
+                            well.score_rules = str_to_scoring.at(val_str);
+                        else
+                            throw std::runtime_error("Invalid scoring value '" + val_str + "', skipped");
+                    }
                 }
                 else
                     throw std::runtime_error("Unknown option '" + key_str + "', ignored");
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "game/Timing.h"
 #include "system/Event.h"
 #include "system/GraphicsContext.h"
 
@@ -13,7 +14,15 @@ public:
     virtual ~GameState() {};
 
     virtual void update(const std::vector<Event>&, AppContext&) = 0;
+    /// Advance the visual-only animations by the real time elapsed since the previous
+    /// call. It's called before drawing, at the display refresh rate, which may differ
+    /// from the fixed rate of `update`. The game logic must not depend on these animations.
+    virtual void updateAnimations(Duration) {}
     virtual void draw(GraphicsContext& gcx) = 0;
+    /// Returns false if drawing the state would produce the same image as in the
+    /// previous frame, in which case drawing and presenting the frame is skipped.
+    /// Frames with events are always drawn.
+    virtual bool needsRedraw() const { return true; }
 
     virtual void on_pause() {}
     virtual void on_resume() {}
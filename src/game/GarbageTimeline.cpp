@@ -0,0 +1,83 @@
+#include "GarbageTimeline.h"
+
+#include <algorithm>
+#include <limits>
+#include <assert.h>
+
+
+constexpr size_t GarbageTimeline::capacity;
+
+GarbageTimeline::GarbageTimeline()
+    : entries()
+    , first(0)
+    , count(0)
+    , total_lines(0)
+{}
+
+const GarbageTimeline::Entry& GarbageTimeline::at(size_t idx) const
+{
+    assert(idx < count);
+    return entries[(first + idx) % capacity];
+}
+
+void GarbageTimeline::push(size_t attacker, unsigned lines, uint32_t arrival_frame, unsigned hole_column)
+{
+    assert(attacker <= std::numeric_limits<uint8_t>::max());
+    assert(hole_column < 16);
+    assert(count == 0 || entry(count - 1).arrival_frame <= arrival_frame);
+    if (!lines)
+        return;
+
+    if (count == capacity) {
+        Entry& last = entry(count - 1);
+        const unsigned merged = std::min<unsigned>(lines, std::numeric_limits<uint16_t>::max() - last.lines);
+        last.lines += merged;
+        total_lines += merged;
+        return;
+    }
+
+    Entry& new_entry = entry(count);
+    new_entry.arrival_frame = arrival_frame;
+    new_entry.lines = std::min<unsigned>(lines, std::numeric_limits<uint16_t>::max());
+    new_entry.attacker = attacker;
+    new_entry.hole_column = hole_column;
+    total_lines += new_entry.lines;
+    count++;
+}
+
+unsigned GarbageTimeline::cancel(unsigned lines)
+{
+    unsigned cancelled = 0;
+    while (count && cancelled < lines) {
+        Entry& oldest = entry(0);
+        const unsigned amount = std::min<unsigned>(oldest.lines, lines - cancelled);
+        oldest.lines -= amount;
+        cancelled += amount;
+        if (!oldest.lines) {
+            first = (first + 1) % capacity;
+            count--;
+        }
+    }
+    total_lines -= cancelled;
+    return cancelled;
+}
+
+unsigned GarbageTimeline::popArrived(uint32_t frame, unsigned well_width, uint16_t* row_masks, unsigned max_rows)
+{
+    assert(well_width > 0 && well_width <= 16);
+    const uint16_t full_row = static_cast<uint16_t>((1u << well_width) - 1);
+
+    unsigned row_count = 0;
+    while (count && entry(0).arrival_frame <= frame) {
+        const Entry& oldest = entry(0);
+        const uint16_t row_mask = full_row & ~(1u << oldest.hole_column);
+        const unsigned rows = std::min<unsigned>(oldest.lines, max_rows - row_count);
+        std::fill_n(row_masks + row_count, rows, row_mask);
+        row_count += rows;
+
+        total_lines -= oldest.lines;
+        first = (first + 1) % capacity;
+        count--;
+    }
+    return row_count;
+}
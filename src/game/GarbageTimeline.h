@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+#include <stddef.h>
+#include <stdint.h>
+
+
+/// The incoming garbage of a player in a battle, as a list of attacks in the
+/// order of their arrival. The attacks are stored in a small ring buffer,
+/// so the timeline never allocates.
+class GarbageTimeline {
+public:
+    struct Entry {
+        uint32_t arrival_frame;
+        uint16_t lines;
+        uint8_t attacker; ///< the slot of the attacking player
+        uint8_t hole_column;
+    };
+    static constexpr size_t capacity = 16;
+
+    GarbageTimeline();
+
+    /// Add an attack. The arrival frames have to be non-decreasing.
+    /// If the ring is full, the lines are merged into the last attack.
+    void push(size_t attacker, unsigned lines, uint32_t arrival_frame, unsigned hole_column);
+    /// Cancel at most `lines` lines, starting with the first attack to arrive,
+    /// which may be cancelled partially. Returns the number of cancelled lines.
+    unsigned cancel(unsigned lines);
+    /// Remove the attacks that arrive until `frame`, and write their rows into
+    /// `row_masks`, from top to bottom, as the bitmasks of the filled cells.
+    /// Rows above `max_rows` would not fit into the well, so they are dropped.
+    /// Returns the number of rows written.
+    unsigned popArrived(uint32_t frame, unsigned well_width, uint16_t* row_masks, unsigned max_rows);
+
+    unsigned totalLines() const { return total_lines; }
+    size_t size() const { return count; }
+    const Entry& at(size_t idx) const;
+
+private:
+    std::array<Entry, capacity> entries;
+    size_t first;
+    size_t count;
+    unsigned total_lines;
+
+    Entry& entry(size_t idx) { return entries[(first + idx) % capacity]; }
+};
@@ -10,12 +10,13 @@ struct PlayerStatistics {
     unsigned short total_cleared_lines;
     unsigned short back_to_back_count;
     unsigned short back_to_back_longest;
-    std::map<ScoreType, unsigned short> event_count;
+    ScoreTypeArray<unsigned short> event_count;
     Duration gametime;
 
     PlayerStatistics()
         : score(0), level(1), total_cleared_lines(0)
         , back_to_back_count(0), back_to_back_longest(0)
+        , event_count()
         , gametime(Duration::zero())
     {}
 };
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <stdint.h>
+
+
+/// The scoring, line award and attack rules of a game
+enum class ScoreRuleSet : uint8_t {
+    GUIDELINE, ///< modern rules, with T-Spin, back-to-back and combo bonuses
+    CLASSIC, ///< only the number of cleared lines matters
+    CUSTOM, ///< the values of the `scoring` block of the game config
+};
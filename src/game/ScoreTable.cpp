@@ -2,55 +2,67 @@
 
 #include "system/Localize.h"
 
-#include <set>
 #include <assert.h>
 
 
-const std::map<ScoreType, unsigned short> ScoreTable::score_table = {
-    {ScoreType::CLEAR_SINGLE, 100},
-    {ScoreType::CLEAR_DOUBLE, 200},
-    {ScoreType::CLEAR_TRIPLE, 500},
-    {ScoreType::CLEAR_PERFECT, 800},
-    {ScoreType::MINI_TSPIN, 100},
-    {ScoreType::CLEAR_MINI_TSPIN_SINGLE, 200},
-    {ScoreType::TSPIN, 400},
-    {ScoreType::CLEAR_TSPIN_SINGLE, 800},
-    {ScoreType::CLEAR_TSPIN_DOUBLE, 1200},
-    {ScoreType::CLEAR_TSPIN_TRIPLE, 1600},
-    {ScoreType::SOFTDROP, 1},
-    {ScoreType::HARDDROP, 2},
-    {ScoreType::COMBO, 50},
+namespace {
+// The columns are in the order of ScoreType:
+// single, double, triple, perfect, mini t-spin, mini t-spin single,
+// t-spin, t-spin single, t-spin double, t-spin triple, softdrop, harddrop, combo
+constexpr ScoreRules guideline_rules = {
+    {{{100, 200, 500, 800, 100, 200, 400, 800, 1200, 1600, 1, 2, 50}}},
+    {{{1, 2, 5, 8, 0, 1, 0, 8, 12, 16, 0, 0, 0}}},
+    {{{0, 1, 2, 4, 0, 0, 0, 2, 4, 6, 0, 0, 0}}},
+    {{{false, false, false, true, false, true, false, true, true, true, false, false, false}}},
+    1.5f,
+    1,
 };
 
-const std::map<ScoreType, const std::string> ScoreTable::score_name = {
-    {ScoreType::CLEAR_SINGLE, tr("SINGLE")},
-    {ScoreType::CLEAR_DOUBLE, tr("DOUBLE")},
-    {ScoreType::CLEAR_TRIPLE, tr("TRIPLE")},
-    {ScoreType::CLEAR_PERFECT, tr("PERFECT!")},
-    {ScoreType::MINI_TSPIN, tr("T-SPIN MINI")},
-    {ScoreType::CLEAR_MINI_TSPIN_SINGLE, tr("T-MINI SINGLE")},
-    {ScoreType::TSPIN, tr("T-SPIN")},
-    {ScoreType::CLEAR_TSPIN_SINGLE, tr("T-SPIN SINGLE")},
-    {ScoreType::CLEAR_TSPIN_DOUBLE, tr("T-SPIN DOUBLE")},
-    {ScoreType::CLEAR_TSPIN_TRIPLE, tr("T-SPIN TRIPLE")},
-    {ScoreType::COMBO, tr(" COMBO")},
+constexpr ScoreRules classic_rules = {
+    {{{40, 100, 300, 1200, 0, 40, 0, 40, 100, 300, 1, 2, 0}}},
+    {{{1, 2, 3, 4, 0, 1, 0, 1, 2, 3, 0, 0, 0}}},
+    {{{0, 1, 2, 4, 0, 0, 0, 0, 1, 2, 0, 0, 0}}},
+    {{{false, false, false, false, false, false, false, false, false, false, false, false, false}}},
+    1.0f,
+    0,
 };
 
-const std::map<ScoreType, unsigned short> ScoreTable::lineaward_table = {
-    {ScoreType::CLEAR_SINGLE, 1},
-    {ScoreType::CLEAR_DOUBLE, 2},
-    {ScoreType::CLEAR_TRIPLE, 5},
-    {ScoreType::CLEAR_PERFECT, 8},
-    {ScoreType::CLEAR_MINI_TSPIN_SINGLE, 1},
-    {ScoreType::CLEAR_TSPIN_SINGLE, 8},
-    {ScoreType::CLEAR_TSPIN_DOUBLE, 12},
-    {ScoreType::CLEAR_TSPIN_TRIPLE, 16},
-};
+static_assert(guideline_rules.score[ScoreType::CLEAR_PERFECT] == 800, "The scoring table is out of order");
+static_assert(classic_rules.line_awards[ScoreType::CLEAR_TSPIN_TRIPLE] == 3, "The line award table is out of order");
+} // namespace
+
+
+const ScoreTypeArray<std::string> ScoreTable::score_name = {{{
+    tr("SINGLE"),
+    tr("DOUBLE"),
+    tr("TRIPLE"),
+    tr("PERFECT!"),
+    tr("T-SPIN MINI"),
+    tr("T-MINI SINGLE"),
+    tr("T-SPIN"),
+    tr("T-SPIN SINGLE"),
+    tr("T-SPIN DOUBLE"),
+    tr("T-SPIN TRIPLE"),
+    "",
+    "",
+    tr(" COMBO"),
+}}};
 
-float ScoreTable::back2back_multiplier = 1.5;
 const std::string ScoreTable::back2back_name = tr("BACK-TO-BACK");
 
 
+const ScoreRules& ScoreTable::rules(ScoreRuleSet rule_set)
+{
+    switch (rule_set) {
+        case ScoreRuleSet::GUIDELINE: return guideline_rules;
+        case ScoreRuleSet::CLASSIC: return classic_rules;
+        case ScoreRuleSet::CUSTOM: break;
+    }
+
+    assert(false);
+    return guideline_rules;
+}
+
 ScoreType ScoreTable::lineclearType(const WellEvent::lineclear_t& lineclear)
 {
     ScoreType score_type = ScoreType::SOFTDROP; // a dummy value
@@ -80,16 +92,3 @@ ScoreType ScoreTable::lineclearType(const WellEvent::lineclear_t& lineclear)
     assert(score_type != ScoreType::SOFTDROP);
     return score_type;
 }
-
-bool ScoreTable::canContinueBackToBack(ScoreType previous, ScoreType current)
-{
-    static const std::set<ScoreType> b2b_allowed = {
-        ScoreType::CLEAR_PERFECT,
-        ScoreType::CLEAR_MINI_TSPIN_SINGLE,
-        ScoreType::CLEAR_TSPIN_SINGLE,
-        ScoreType::CLEAR_TSPIN_DOUBLE,
-        ScoreType::CLEAR_TSPIN_TRIPLE,
-    };
-
-    return b2b_allowed.count(current) && b2b_allowed.count(previous);
-}
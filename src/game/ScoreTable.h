@@ -1,9 +1,11 @@
 #pragma once
 
+#include "ScoreRuleSet.h"
 #include "WellEvent.h"
 
-#include <map>
+#include <array>
 #include <string>
+#include <stddef.h>
 
 
 enum class ScoreType : unsigned char {
@@ -21,25 +23,51 @@ enum class ScoreType : unsigned char {
     HARDDROP,
     COMBO,
 };
+constexpr size_t score_type_count = static_cast<size_t>(ScoreType::COMBO) + 1;
+
+
+/// A fixed size array, indexed by ScoreType
+template <typename T>
+struct ScoreTypeArray {
+    std::array<T, score_type_count> values;
+
+    constexpr const T& operator[](ScoreType type) const { return values[static_cast<size_t>(type)]; }
+    T& operator[](ScoreType type) { return values[static_cast<size_t>(type)]; }
+};
+
+
+/// The values of a rule set. Every table is indexed by ScoreType,
+/// so the lookups are simple array reads.
+struct ScoreRules {
+    ScoreTypeArray<unsigned short> score;
+    ScoreTypeArray<unsigned short> line_awards;
+    ScoreTypeArray<unsigned char> attack_lines; ///< the garbage lines sent in battles
+    ScoreTypeArray<bool> continues_back2back;
+    float back2back_multiplier;
+    unsigned char back2back_attack_bonus;
+
+    unsigned short value(ScoreType type) const { return score[type]; }
+    unsigned short lineAwards(ScoreType type) const { return line_awards[type]; }
+    bool canContinueBackToBack(ScoreType previous, ScoreType current) const {
+        return continues_back2back[previous] && continues_back2back[current];
+    }
+    unsigned sendableLineCount(ScoreType type, bool is_b2b) const {
+        return attack_lines[type] + (is_b2b ? back2back_attack_bonus : 0);
+    }
+};
 
 
 class ScoreTable {
 public:
-    static unsigned short value(ScoreType type) { return score_table.at(type); }
-    static const std::string& name(ScoreType type) { return score_name.at(type); }
+    /// The values of a built-in rule set. The custom values are stored in the WellConfig.
+    static const ScoreRules& rules(ScoreRuleSet);
 
-    static ScoreType lineclearType(const WellEvent::lineclear_t&);
-    static unsigned short lineAwards(ScoreType type) { return lineaward_table.at(type); }
+    static const std::string& name(ScoreType type) { return score_name[type]; }
+    static const std::string& back2backName() { return back2back_name; }
 
-    static bool canContinueBackToBack(ScoreType previous, ScoreType current);
-    static float back2backMultiplier() { return back2back_multiplier; }
-    static const std::string back2backName() { return back2back_name; }
+    static ScoreType lineclearType(const WellEvent::lineclear_t&);
 
 private:
-    static const std::map<ScoreType, unsigned short> score_table;
-    static const std::map<ScoreType, const std::string> score_name;
-    static const std::map<ScoreType, unsigned short> lineaward_table;
-
-    static float back2back_multiplier;
+    static const ScoreTypeArray<std::string> score_name;
     static const std::string back2back_name;
 };
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "FramePacing.h"
+
 #include <string>
 
 
@@ -7,12 +9,16 @@ struct SysConfig {
     bool fullscreen;
     bool sfx;
     bool music;
+    bool parallel_wells; ///< update the wells of the players on multiple threads
+    FramePacing frame_pacing;
     std::string theme_dir_name;
 
     SysConfig()
         : fullscreen(false)
         , sfx(true)
         , music(true)
+        , parallel_wells(false)
+        , frame_pacing(FramePacing::VSYNC)
         , theme_dir_name("default")
     {}
 };
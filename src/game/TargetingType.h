@@ -0,0 +1,11 @@
+#pragma once
+
+#include <stdint.h>
+
+
+/// How the target of a garbage attack is chosen in battle games
+enum class TargetingType : uint8_t {
+    RANDOM, ///< a random opponent
+    ATTACKERS, ///< the last opponent who attacked the player, or a random one
+    KO_FOCUSED, ///< everyone attacks the same opponent, until they are knocked out
+};
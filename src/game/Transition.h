@@ -1,8 +1,8 @@
 #pragma once
 
 #include "game/Timing.h"
+#include "game/util/Delegate.h"
 
-#include <functional>
 #include <assert.h>
 
 
@@ -33,10 +33,10 @@ public:
     }
 
 protected:
-    TransitionBase(Duration duration, std::function<void()> on_end)
+    TransitionBase(Duration duration, Delegate<void()>&& on_end)
         : duration(duration)
         , timer(Duration::zero())
-        , end_callback(on_end)
+        , end_callback(std::move(on_end))
         , is_running(true)
     {
         assert(duration > Duration::zero());
@@ -49,7 +49,7 @@ protected:
 
     Duration duration;
     Duration timer;
-    std::function<void()> end_callback;
+    Delegate<void()> end_callback;
     bool is_running;
 };
 
@@ -69,15 +69,17 @@ public:
     /// After the elapsed time reaches the duration (by repeatedly calling update()), on_update will
     /// be called with the value 1.0, then on_end_cb will be called,
     /// after that the transition stops and never calls any of the functions again.
-    Transition(Duration duration, std::function<T(double)> on_update, std::function<void()> on_end = [](){})
-        : TransitionBase(duration, on_end)
-        , animator(on_update)
+    ///
+    /// The functions are stored inline, so creating a Transition never allocates.
+    Transition(Duration duration, Delegate<T(double)>&& on_update, Delegate<void()>&& on_end = [](){})
+        : TransitionBase(duration, std::move(on_end))
+        , animator(std::move(on_update))
         , last_value(animator(0.0))
     {}
 
     /// Replace the on-update function.
-    void replaceFn(std::function<T(double)> on_update) {
-        animator = on_update;
+    void replaceFn(Delegate<T(double)>&& on_update) {
+        animator = std::move(on_update);
         update(Duration::zero());
     }
 
@@ -107,22 +109,22 @@ public:
     const T& value() const { return last_value; }
 
 private:
-    std::function<T(double)> animator;
+    Delegate<T(double)> animator;
     T last_value;
 };
 
 template<>
 class Transition<void> : public TransitionBase {
 public:
-    Transition(Duration duration, std::function<void(double)> on_update, std::function<void()> on_end = [](){})
-        : TransitionBase(duration, on_end)
-        , animator(on_update)
+    Transition(Duration duration, Delegate<void(double)>&& on_update, Delegate<void()>&& on_end = [](){})
+        : TransitionBase(duration, std::move(on_end))
+        , animator(std::move(on_update))
     {
-        on_update(0.0);
+        animator(0.0);
     }
 
-    void replaceFn(std::function<void(double)> on_update) {
-        animator = on_update;
+    void replaceFn(Delegate<void(double)>&& on_update) {
+        animator = std::move(on_update);
         update(Duration::zero());
     }
 
@@ -148,5 +150,5 @@ public:
     void value() const {}
 
 private:
-    std::function<void(double)> animator;
+    Delegate<void(double)> animator;
 };
@@ -1,6 +1,10 @@
 #pragma once
 
+#include "ScoreRuleSet.h"
+#include "ScoreTable.h"
+#include "TargetingType.h"
 #include "components/LockDelayType.h"
+#include "components/randomizers/RandomizerType.h"
 #include "components/rotations/RotationStyle.h"
 
 #include <memory>
@@ -19,6 +23,11 @@ struct WellConfig {
     bool tspin_allow_wallblock;
     bool tspin_allow_wallkick;
     RotationStyle rotation_style;
+    RandomizerType randomizer;
+    TargetingType battle_targeting;
+    ScoreRuleSet score_rules;
+    ScoreRules custom_score_rules; ///< the values of the CUSTOM rule set
+    unsigned short garbage_delay; ///< the travel time of the garbage sent in battles
 
     WellConfig() {
         starting_gravity = 64,
@@ -32,5 +41,10 @@ struct WellConfig {
         tspin_allow_wallblock = true,
         tspin_allow_wallkick = true,
         rotation_style = RotationStyle::SRS;
+        randomizer = RandomizerType::BAG7;
+        battle_targeting = TargetingType::RANDOM;
+        score_rules = ScoreRuleSet::GUIDELINE;
+        custom_score_rules = ScoreTable::rules(ScoreRuleSet::GUIDELINE);
+        garbage_delay = 60;
     };
 };
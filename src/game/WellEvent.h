@@ -23,6 +23,7 @@ struct WellEvent {
         HARDDROPPED,
         GAME_OVER,
     };
+    static constexpr unsigned type_count = static_cast<unsigned>(Type::GAME_OVER) + 1;
 
     struct harddrop_t {
         uint8_t count;
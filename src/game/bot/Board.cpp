@@ -0,0 +1,82 @@
+#include "Board.h"
+
+#include <assert.h>
+
+
+namespace Bot {
+
+constexpr unsigned Board::width;
+constexpr unsigned Board::height;
+constexpr unsigned Board::spawn_row;
+constexpr uint16_t Board::full_row;
+
+Board::Board()
+{
+    rows.fill(0);
+}
+
+bool Board::collides(const PieceShape& shape, unsigned x, unsigned bottom_row) const
+{
+    for (unsigned i = 0; i < shape.height; i++) {
+        const unsigned board_row = bottom_row + shape.height - 1 - i;
+        if (board_row >= height || (rows[board_row] & (shape.rows[i] << x)))
+            return true;
+    }
+    return false;
+}
+
+unsigned Board::place(const PieceShapes& shapes, const Placement& placement)
+{
+    const auto& shape = shapes.get(placement.type, placement.direction);
+    const unsigned x = placement.x + shape.grid_col;
+    assert(x + shape.width <= width);
+    assert(!collides(shape, x, placement.row));
+
+    for (unsigned i = 0; i < shape.height; i++)
+        rows[placement.row + shape.height - 1 - i] |= shape.rows[i] << x;
+
+    unsigned cleared = 0;
+    unsigned write_row = placement.row;
+    for (unsigned read_row = placement.row; read_row < height; read_row++) {
+        if (rows[read_row] == full_row) {
+            cleared++;
+            continue;
+        }
+        rows[write_row++] = rows[read_row];
+    }
+    for (; write_row < height; write_row++)
+        rows[write_row] = 0;
+
+    return cleared;
+}
+
+void Board::addGarbageLines(unsigned count, unsigned hole_col)
+{
+    assert(hole_col < width);
+    if (!count)
+        return;
+
+    count = std::min(count, height);
+    for (unsigned row = height; row-- > count;)
+        rows[row] = rows[row - count];
+
+    const uint16_t garbage_row = full_row & ~(1 << hole_col);
+    for (unsigned row = 0; row < count; row++)
+        rows[row] = garbage_row;
+}
+
+unsigned Board::stackHeight() const
+{
+    for (unsigned row = height; row > 0; row--) {
+        if (rows[row - 1])
+            return row;
+    }
+    return 0;
+}
+
+bool Board::isEmpty() const
+{
+    return stackHeight() == 0;
+}
+
+} // namespace Bot
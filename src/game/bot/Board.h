@@ -0,0 +1,81 @@
+#pragma once
+
+#include "PieceShapes.h"
+
+#include <array>
+#include <stdint.h>
+
+
+namespace Bot {
+
+/// A hard drop placement of a piece on a Board.
+struct Placement {
+    PieceType type;
+    PieceDirection direction;
+    int8_t x; ///< the target column of the 4x4 piece grid, as in the Well
+    uint8_t row; ///< the bottom row of the piece after landing
+    bool uses_hold;
+};
+
+/// A lightweight, bitmask based copy of a Well's grid, used for simulating
+/// games without the game logic and graphics of the real Well.
+/// Row 0 is the bottom row, and the leftmost column is the lowest bit.
+class Board {
+public:
+    static constexpr unsigned width = 10;
+    static constexpr unsigned height = 40;
+    /// Pieces enter the board at this row
+    static constexpr unsigned spawn_row = 20;
+    static constexpr uint16_t full_row = (1 << width) - 1;
+
+    Board();
+
+    uint16_t row(unsigned i) const { return rows[i]; }
+    const std::array<uint16_t, height>& allRows() const { return rows; }
+
+    /// Call `fn` with every possible hard drop placement of a piece
+    template <typename Fn>
+    void forEachPlacement(const PieceShapes&, PieceType, bool uses_hold, Fn&& fn) const;
+
+    /// Put the piece on the board, then remove the filled rows.
+    /// Returns the number of cleared lines.
+    unsigned place(const PieceShapes&, const Placement&);
+    /// Push up the contents of the board, and fill the bottom rows with
+    /// garbage, leaving a hole in the provided column.
+    void addGarbageLines(unsigned count, unsigned hole_col);
+
+    /// Returns the number of rows, counted from the bottom, that contain any cells
+    unsigned stackHeight() const;
+    /// Returns true if the board has no cells
+    bool isEmpty() const;
+
+private:
+    std::array<uint16_t, height> rows;
+
+    bool collides(const PieceShape&, unsigned x, unsigned bottom_row) const;
+};
+
+
+template <typename Fn>
+void Board::forEachPlacement(const PieceShapes& shapes, PieceType type, bool uses_hold, Fn&& fn) const
+{
+    for (uint8_t dir = 0; dir < 4; dir++) {
+        const auto direction = static_cast<PieceDirection>(dir);
+        const auto& shape = shapes.get(type, direction);
+        if (shape.duplicate)
+            continue;
+
+        for (unsigned x = 0; x + shape.width <= width; x++) {
+            unsigned y = spawn_row;
+            if (collides(shape, x, y))
+                continue;
+            while (y > 0 && !collides(shape, x, y - 1))
+                y--;
+
+            fn(Placement {type, direction, static_cast<int8_t>(x - shape.grid_col),
+                          static_cast<uint8_t>(y), uses_hold});
+        }
+    }
+}
+
+} // namespace Bot
@@ -0,0 +1,231 @@
+#include "DatasetWriter.h"
+
+#include "game/util/PackBits.h"
+#include "system/Log.h"
+
+#include <stdexcept>
+#include <assert.h>
+
+
+namespace Bot {
+
+constexpr unsigned DatasetRecord::board_rows;
+constexpr unsigned DatasetRecord::queue_length;
+constexpr uint8_t DatasetRecord::no_piece;
+constexpr uint16_t DatasetWriter::format_version;
+constexpr uint8_t DatasetWriter::flag_delta;
+
+namespace {
+const std::string LOG_TAG = "dataset";
+
+struct Column {
+    std::string name;
+    uint8_t width;
+    uint8_t flags;
+    uint32_t (*value)(const DatasetRecord&, unsigned index);
+    unsigned index;
+};
+
+std::vector<Column> createColumns()
+{
+    using R = const DatasetRecord&;
+    std::vector<Column> columns = {
+        {"game_id", 4, DatasetWriter::flag_delta, [](R r, unsigned){ return uint32_t(r.game_id); }, 0},
+        {"move", 2, DatasetWriter::flag_delta, [](R r, unsigned){ return uint32_t(r.move); }, 0},
+        {"player", 1, 0, [](R r, unsigned){ return uint32_t(r.player); }, 0},
+    };
+    for (unsigned i = 0; i < DatasetRecord::board_rows; i++) {
+        const std::string num = (i < 10 ? "0" : "") + std::to_string(i);
+        columns.push_back({"board_" + num, 2, 0, [](R r, unsigned idx){ return uint32_t(r.board[idx]); }, i});
+    }
+    for (unsigned i = 0; i < DatasetRecord::queue_length; i++)
+        columns.push_back({"queue_" + std::to_string(i), 1, 0, [](R r, unsigned idx){ return uint32_t(r.queue[idx]); }, i});
+
+    const std::vector<Column> tail = {
+        {"hold", 1, 0, [](R r, unsigned){ return uint32_t(r.hold); }, 0},
+        {"pending_garbage", 1, 0, [](R r, unsigned){ return uint32_t(r.pending_garbage); }, 0},
+        {"placement_type", 1, 0, [](R r, unsigned){ return uint32_t(r.placement_type); }, 0},
+        {"placement_direction", 1, 0, [](R r, unsigned){ return uint32_t(r.placement_direction); }, 0},
+        {"placement_x", 1, 0, [](R r, unsigned){ return uint32_t(uint8_t(r.placement_x)); }, 0},
+        {"placement_row", 1, 0, [](R r, unsigned){ return uint32_t(r.placement_row); }, 0},
+        {"placement_uses_hold", 1, 0, [](R r, unsigned){ return uint32_t(r.placement_uses_hold); }, 0},
+        {"cleared_lines", 1, 0, [](R r, unsigned){ return uint32_t(r.cleared_lines); }, 0},
+        {"sent_lines", 1, 0, [](R r, unsigned){ return uint32_t(r.sent_lines); }, 0},
+        {"outcome", 1, 0, [](R r, unsigned){ return uint32_t(uint8_t(r.outcome)); }, 0},
+        {"moves_left", 2, 0, [](R r, unsigned){ return uint32_t(r.moves_left); }, 0},
+    };
+    columns.insert(columns.end(), tail.begin(), tail.end());
+    return columns;
+}
+
+const std::vector<Column>& columns()
+{
+    static const std::vector<Column> cols = createColumns();
+    return cols;
+}
+
+void appendU8(std::vector<uint8_t>& out, uint8_t value)
+{
+    out.push_back(value);
+}
+
+void appendU16(std::vector<uint8_t>& out, uint16_t value)
+{
+    out.push_back(value & 0xFF);
+    out.push_back(value >> 8);
+}
+
+void appendU32(std::vector<uint8_t>& out, uint32_t value)
+{
+    for (unsigned i = 0; i < 4; i++)
+        out.push_back((value >> (i * 8)) & 0xFF);
+}
+} // namespace
+
+
+DatasetWriter::DatasetWriter(const std::string& path, size_t chunk_size, size_t queue_capacity)
+    : chunk_size(chunk_size)
+    , queue_capacity(queue_capacity)
+    , file(std::fopen(path.c_str(), "wb"))
+    , closing(false)
+    , write_failed(false)
+    , written_records(0)
+{
+    assert(chunk_size > 0);
+    assert(queue_capacity > 0);
+    if (!file)
+        throw std::runtime_error("Could not open '" + path + "' for writing");
+
+    chunk.reserve(chunk_size);
+    writeHeader();
+    thread = std::thread(&DatasetWriter::writerLoop, this);
+}
+
+DatasetWriter::~DatasetWriter()
+{
+    finish();
+}
+
+void DatasetWriter::push(std::vector<DatasetRecord>&& batch)
+{
+    if (batch.empty())
+        return;
+
+    std::unique_lock<std::mutex> lock(queue_mutex);
+    assert(!closing);
+    queue_not_full.wait(lock, [this](){ return queue.size() < queue_capacity; });
+    queue.push_back(std::move(batch));
+    lock.unlock();
+    queue_not_empty.notify_one();
+}
+
+bool DatasetWriter::finish()
+{
+    if (!thread.joinable())
+        return !write_failed;
+
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        closing = true;
+    }
+    queue_not_empty.notify_one();
+    thread.join();
+
+    if (std::fclose(file) != 0)
+        write_failed = true;
+    file = nullptr;
+
+    if (write_failed)
+        Log::error(LOG_TAG) << "Could not write the dataset file\n";
+    return !write_failed;
+}
+
+void DatasetWriter::writerLoop()
+{
+    std::vector<DatasetRecord> batch;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            queue_not_empty.wait(lock, [this](){ return !queue.empty() || closing; });
+            if (queue.empty())
+                break;
+
+            batch = std::move(queue.front());
+            queue.pop_front();
+        }
+        queue_not_full.notify_one();
+
+        for (const auto& record : batch) {
+            chunk.push_back(record);
+            if (chunk.size() == chunk_size)
+                writeChunk();
+        }
+    }
+
+    writeChunk();
+}
+
+void DatasetWriter::writeHeader()
+{
+    output.clear();
+    output.insert(output.end(), {'O', 'B', 'S', 'P'});
+    appendU16(output, format_version);
+    appendU16(output, columns().size());
+    for (const auto& column : columns()) {
+        appendU8(output, column.name.size());
+        output.insert(output.end(), column.name.begin(), column.name.end());
+        appendU8(output, column.width);
+        appendU8(output, column.flags);
+    }
+    writeOutput();
+}
+
+void DatasetWriter::writeChunk()
+{
+    if (chunk.empty())
+        return;
+
+    output.clear();
+    appendU32(output, chunk.size());
+
+    for (const auto& column : columns()) {
+        column_values.clear();
+        for (const auto& record : chunk)
+            column_values.push_back(column.value(record, column.index));
+
+        if (column.flags & flag_delta) {
+            for (size_t i = column_values.size() - 1; i > 0; i--)
+                column_values[i] -= column_values[i - 1];
+        }
+
+        column_planes.clear();
+        for (unsigned byte = 0; byte < column.width; byte++) {
+            for (const uint32_t value : column_values)
+                column_planes.push_back((value >> (byte * 8)) & 0xFF);
+        }
+
+        // the length is filled in after compression
+        const size_t length_pos = output.size();
+        appendU32(output, 0);
+        PackBits::encode(column_planes.data(), column_planes.size(), output);
+
+        const uint32_t length = output.size() - length_pos - 4;
+        for (unsigned i = 0; i < 4; i++)
+            output[length_pos + i] = (length >> (i * 8)) & 0xFF;
+    }
+
+    writeOutput();
+    written_records += chunk.size();
+    chunk.clear();
+}
+
+void DatasetWriter::writeOutput()
+{
+    if (write_failed)
+        return;
+
+    if (std::fwrite(output.data(), 1, output.size(), file) != output.size())
+        write_failed = true;
+}
+
+} // namespace Bot
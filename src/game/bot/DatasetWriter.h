@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+
+
+namespace Bot {
+
+/// One decision of a bot during a self-play game.
+struct DatasetRecord {
+    static constexpr unsigned board_rows = 24;
+    static constexpr unsigned queue_length = 6; ///< the current piece and 5 previews
+    static constexpr uint8_t no_piece = 0xFF;
+
+    uint32_t game_id;
+    uint16_t move; ///< the index of the move in the game, for this player
+    uint8_t player;
+    std::array<uint16_t, board_rows> board; ///< bottom row first, leftmost column in the lowest bit
+    std::array<uint8_t, queue_length> queue; ///< PieceType values
+    uint8_t hold; ///< PieceType value or `no_piece`
+    uint8_t pending_garbage; ///< lines that will be added before the next piece
+
+    uint8_t placement_type;
+    uint8_t placement_direction;
+    int8_t placement_x; ///< the column of the 4x4 piece grid, as in the Well
+    uint8_t placement_row; ///< the bottom row of the piece after landing
+    uint8_t placement_uses_hold;
+
+    uint8_t cleared_lines;
+    uint8_t sent_lines;
+    int8_t outcome; ///< 1 if the player won, -1 if lost, 0 otherwise
+    uint16_t moves_left; ///< the number of moves of this player until the game ended
+};
+
+/// Streams self-play records to a file on a background thread.
+///
+/// The file starts with a header, then contains independently decodable
+/// chunks. Every value is little endian.
+///
+///     header: "OBSP", u16 version, u16 column count,
+///             then for every column: u8 name length, name, u8 value width, u8 flags
+///     chunk:  u32 record count,
+///             then for every column: u32 data length, data
+///
+/// The column data contains the values of the chunk's records as byte planes
+/// (every lowest byte first, then every second byte, and so on), compressed
+/// with PackBits. If flag 0x1 is set, the values are stored as the wrapping
+/// difference to the previous value in the chunk.
+class DatasetWriter {
+public:
+    static constexpr uint16_t format_version = 1;
+    static constexpr uint8_t flag_delta = 0x1;
+
+    /// Open the output file and start the writer thread. Throws `std::runtime_error`
+    /// if the file can not be opened. `chunk_size` is the number of records per chunk,
+    /// `queue_capacity` is the number of batches waiting to be written at most.
+    DatasetWriter(const std::string& path, size_t chunk_size = 1 << 16, size_t queue_capacity = 64);
+    ~DatasetWriter();
+
+    /// Queue a batch of records for writing. Only blocks if the writer thread
+    /// is behind by `queue_capacity` batches.
+    void push(std::vector<DatasetRecord>&& batch);
+    /// Write out the remaining records and close the file.
+    /// Returns false if there was a write error.
+    bool finish();
+
+    /// The number of records written so far; final after `finish()`
+    uint64_t writtenRecords() const { return written_records; }
+
+private:
+    const size_t chunk_size;
+    const size_t queue_capacity;
+    FILE* file;
+
+    std::mutex queue_mutex;
+    std::condition_variable queue_not_empty;
+    std::condition_variable queue_not_full;
+    std::deque<std::vector<DatasetRecord>> queue;
+    bool closing;
+
+    // owned by the writer thread
+    std::vector<DatasetRecord> chunk;
+    std::vector<uint32_t> column_values;
+    std::vector<uint8_t> column_planes;
+    std::vector<uint8_t> output;
+    bool write_failed;
+
+    std::atomic<uint64_t> written_records; ///< updated by the writer thread
+
+    std::thread thread;
+
+    void writerLoop();
+    void writeHeader();
+    void writeChunk();
+    void writeOutput();
+};
+
+} // namespace Bot
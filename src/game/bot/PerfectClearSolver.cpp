@@ -0,0 +1,364 @@
+#include "PerfectClearSolver.h"
+
+#include "game/components/HoldQueue.h"
+#include "game/components/NextQueue.h"
+#include "game/components/Piece.h"
+#include "game/components/Well.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <assert.h>
+
+
+namespace Bot {
+
+namespace {
+constexpr unsigned field_width = 10;
+constexpr unsigned max_field_height = 6; // 60 bits fit into an uint64_t
+constexpr uint64_t full_row = (1 << field_width) - 1;
+constexpr int8_t no_hold = -1;
+
+// A 10 column wide board segment, row 0 being the bottom row
+// and column 0 being the lowest bit of a row.
+using Field = uint64_t;
+
+unsigned cellCount(Field field)
+{
+    return std::bitset<64>(field).count();
+}
+
+// The piece masks at the bottom of the field, for every column
+using PieceMasks = std::array<std::array<std::array<Field, field_width>, 4>, PieceTypeList.size()>;
+
+PieceMasks createPieceMasks(const PieceShapes& shapes)
+{
+    PieceMasks masks = {};
+    for (const PieceType type : PieceTypeList) {
+        for (uint8_t dir = 0; dir < 4; dir++) {
+            const auto& shape = shapes.get(type, static_cast<PieceDirection>(dir));
+            for (unsigned x = 0; x + shape.width <= field_width; x++) {
+                Field mask = 0;
+                for (unsigned row = 0; row < shape.height; row++) {
+                    const unsigned field_row = shape.height - 1 - row;
+                    mask |= (static_cast<Field>(shape.rows[row]) << x) << (field_row * field_width);
+                }
+                masks[static_cast<size_t>(type)][dir][x] = mask;
+            }
+        }
+    }
+    return masks;
+}
+
+struct Placement {
+    Field field;
+    uint8_t height;
+    PerfectClearStep step;
+};
+
+struct SearchNode {
+    Field field;
+    uint8_t height;
+    uint8_t piece_idx; ///< the next unused piece
+    int8_t hold;
+
+    bool operator==(const SearchNode& other) const {
+        return field == other.field && height == other.height
+            && piece_idx == other.piece_idx && hold == other.hold;
+    }
+};
+
+struct SearchNodeHash {
+    size_t operator()(const SearchNode& node) const {
+        const uint64_t meta = (static_cast<uint64_t>(node.height) << 16)
+                            | (static_cast<uint64_t>(node.piece_idx) << 8)
+                            | static_cast<uint8_t>(node.hold);
+        return static_cast<size_t>((node.field ^ (meta << 58) ^ (meta >> 6)) * 0x9E3779B97F4A7C15ull);
+    }
+};
+
+/// The shared, read-only parts of a search
+struct SearchInput {
+    const PieceShapes& shapes;
+    const PieceMasks& masks;
+    const std::vector<PieceType>& pieces;
+    std::chrono::steady_clock::time_point deadline;
+};
+
+/// The state of one search thread
+class Searcher {
+public:
+    Searcher(const SearchInput& input, std::atomic<bool>& stop_flag)
+        : input(input)
+        , stop_flag(stop_flag)
+        , timed_out(false)
+        , nodes(0)
+    {}
+
+    /// Call `fn` with every possible hard drop placement of a piece
+    template <typename Fn>
+    void forEachPlacement(Field field, uint8_t height, PieceType type, bool uses_hold, Fn&& fn) const
+    {
+        for (uint8_t dir = 0; dir < 4; dir++) {
+            const auto direction = static_cast<PieceDirection>(dir);
+            const auto& shape = input.shapes.get(type, direction);
+            if (shape.duplicate || shape.height > height)
+                continue;
+
+            const auto& masks = input.masks[static_cast<size_t>(type)][dir];
+            for (unsigned x = 0; x + shape.width <= field_width; x++) {
+                const Field mask = masks[x];
+
+                // the piece comes from above the area
+                unsigned y = height - shape.height;
+                if ((mask << (y * field_width)) & field)
+                    continue;
+                while (y > 0 && !((mask << ((y - 1) * field_width)) & field))
+                    y--;
+
+                Placement placement;
+                placement.field = field | (mask << (y * field_width));
+                placement.height = height;
+                placement.step = {type, direction, static_cast<int8_t>(x - shape.grid_col), uses_hold};
+
+                // remove the filled rows, from top to bottom
+                for (int row = y + shape.height - 1; row >= static_cast<int>(y); row--) {
+                    if (((placement.field >> (row * field_width)) & full_row) != full_row)
+                        continue;
+
+                    const Field below = placement.field & ((static_cast<Field>(1) << (row * field_width)) - 1);
+                    const Field above = placement.field >> ((row + 1) * field_width);
+                    placement.field = below | (above << (row * field_width));
+                    placement.height--;
+                }
+
+                fn(placement);
+            }
+        }
+    }
+
+    /// Call `fn` with the placements of the current piece, and also
+    /// with the placements available by using the hold queue
+    template <typename Fn>
+    void forEachMove(const SearchNode& node, Fn&& fn) const
+    {
+        const auto& pieces = input.pieces;
+        if (node.piece_idx >= pieces.size())
+            return;
+
+        const PieceType current = pieces[node.piece_idx];
+        forEachPlacement(node.field, node.height, current, false, [&](const Placement& p){
+            fn(p, SearchNode {p.field, p.height, static_cast<uint8_t>(node.piece_idx + 1), node.hold});
+        });
+
+        if (node.hold == no_hold) {
+            if (node.piece_idx + 1u >= pieces.size() || pieces[node.piece_idx + 1] == current)
+                return;
+
+            const PieceType next = pieces[node.piece_idx + 1];
+            const int8_t new_hold = static_cast<int8_t>(current);
+            forEachPlacement(node.field, node.height, next, true, [&](const Placement& p){
+                fn(p, SearchNode {p.field, p.height, static_cast<uint8_t>(node.piece_idx + 2), new_hold});
+            });
+        }
+        else if (static_cast<PieceType>(node.hold) != current) {
+            const PieceType held = static_cast<PieceType>(node.hold);
+            const int8_t new_hold = static_cast<int8_t>(current);
+            forEachPlacement(node.field, node.height, held, true, [&](const Placement& p){
+                fn(p, SearchNode {p.field, p.height, static_cast<uint8_t>(node.piece_idx + 1), new_hold});
+            });
+        }
+    }
+
+    /// Returns true if the node can not lead to a perfect clear for sure
+    bool isDeadEnd(const SearchNode& node) const
+    {
+        const unsigned empty_cells = node.height * field_width - cellCount(node.field);
+        const unsigned available_pieces = (input.pieces.size() - node.piece_idx) + (node.hold != no_hold);
+        if (empty_cells % 4 || empty_cells > available_pieces * 4)
+            return true;
+
+        // fully filled columns split the area into parts that
+        // have to be filled separately
+        Field column_mask = 0;
+        for (unsigned row = 0; row < node.height; row++)
+            column_mask |= static_cast<Field>(1) << (row * field_width);
+
+        unsigned part_empty_cells = 0;
+        for (unsigned col = 0; col < field_width; col++) {
+            const unsigned filled = cellCount(node.field & (column_mask << col));
+            if (filled == node.height) {
+                if (part_empty_cells % 4)
+                    return true;
+                part_empty_cells = 0;
+            }
+            else
+                part_empty_cells += node.height - filled;
+        }
+        return part_empty_cells % 4;
+    }
+
+    bool search(const SearchNode& node)
+    {
+        if (node.height == 0)
+            return true;
+        if (stop_flag.load(std::memory_order_relaxed))
+            return false;
+
+        nodes++;
+        if ((nodes & 0xFF) == 0 && std::chrono::steady_clock::now() >= input.deadline) {
+            timed_out = true;
+            stop_flag = true;
+            return false;
+        }
+
+        if (isDeadEnd(node) || dead_ends.count(node))
+            return false;
+
+        bool found = false;
+        forEachMove(node, [this, &found](const Placement& placement, const SearchNode& child){
+            if (found)
+                return;
+
+            steps.push_back(placement.step);
+            if (search(child))
+                found = true;
+            else
+                steps.pop_back();
+        });
+
+        if (!found && !stop_flag.load(std::memory_order_relaxed))
+            dead_ends.insert(node);
+        return found;
+    }
+
+    const SearchInput& input;
+    std::atomic<bool>& stop_flag;
+    bool timed_out;
+    unsigned long long nodes;
+    std::vector<PerfectClearStep> steps;
+    std::unordered_set<SearchNode, SearchNodeHash> dead_ends;
+};
+} // namespace
+
+
+PerfectClearSolver::PerfectClearSolver(Settings settings)
+    : settings(settings)
+{
+    assert(0 < settings.max_lines && settings.max_lines <= max_field_height);
+}
+
+PerfectClearResult PerfectClearSolver::solve(const Well& well, const NextQueue& next_queue,
+                                             const HoldQueue& hold_queue) const
+{
+    std::vector<uint16_t> rows;
+    for (int row = Well::matrix_rows - 1; row >= 0; row--)
+        rows.push_back(well.rowMask(row));
+
+    std::vector<PieceType> pieces;
+    if (well.activePiece())
+        pieces.push_back(well.activePiece()->type());
+    for (unsigned i = 0; i < next_queue.previewCount(); i++)
+        pieces.push_back(next_queue.preview(i));
+
+    return solve(rows, pieces, !hold_queue.isEmpty(), hold_queue.heldPiece());
+}
+
+PerfectClearResult PerfectClearSolver::solve(const std::vector<uint16_t>& rows,
+                                             const std::vector<PieceType>& pieces,
+                                             bool has_hold, PieceType hold) const
+{
+    PerfectClearResult result;
+    result.found = false;
+    result.timed_out = false;
+    result.lines = 0;
+    result.searched_nodes = 0;
+
+    const auto deadline = std::chrono::steady_clock::now() + settings.time_limit;
+
+    // everything has to be under the maximum height
+    Field field = 0;
+    unsigned stack_height = 0;
+    for (unsigned row = 0; row < rows.size(); row++) {
+        const uint16_t row_mask = rows[row] & full_row;
+        if (!row_mask)
+            continue;
+        if (row >= settings.max_lines)
+            return result;
+
+        field |= static_cast<Field>(row_mask) << (row * field_width);
+        stack_height = row + 1;
+    }
+    // the piece indices should fit into the search nodes
+    if (pieces.empty() || pieces.size() > 0xFF)
+        return result;
+
+    const PieceMasks masks = createPieceMasks(shapes);
+    const SearchInput input {shapes, masks, pieces, deadline};
+    const unsigned thread_count = settings.thread_count
+        ? settings.thread_count
+        : std::max(1u, std::thread::hardware_concurrency());
+
+    for (unsigned height = std::max(1u, stack_height); height <= settings.max_lines; height++) {
+        const SearchNode root {field, static_cast<uint8_t>(height), 0,
+                               has_hold ? static_cast<int8_t>(hold) : no_hold};
+
+        std::atomic<bool> stop_flag(false);
+        {
+            Searcher probe(input, stop_flag);
+            if (probe.isDeadEnd(root))
+                continue;
+        }
+
+        // the first level of the search tree is split between the threads
+        std::vector<std::pair<Placement, SearchNode>> first_moves;
+        Searcher(input, stop_flag).forEachMove(root, [&first_moves](const Placement& p, const SearchNode& child){
+            first_moves.emplace_back(p, child);
+        });
+
+        std::atomic<size_t> next_move(0);
+        std::mutex result_mutex;
+        auto worker = [&](){
+            Searcher searcher(input, stop_flag);
+            size_t move_idx;
+            while ((move_idx = next_move++) < first_moves.size()) {
+                const auto& move = first_moves[move_idx];
+                searcher.steps.clear();
+                if (searcher.search(move.second)) {
+                    std::lock_guard<std::mutex> lock(result_mutex);
+                    if (!result.found) {
+                        result.found = true;
+                        result.lines = height;
+                        result.steps.push_back(move.first.step);
+                        result.steps.insert(result.steps.end(), searcher.steps.begin(), searcher.steps.end());
+                    }
+                    stop_flag = true;
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(result_mutex);
+            result.searched_nodes += searcher.nodes;
+            result.timed_out |= searcher.timed_out;
+        };
+
+        std::vector<std::thread> threads;
+        const size_t worker_count = std::min<size_t>(thread_count, first_moves.size());
+        for (size_t i = 1; i < worker_count; i++)
+            threads.emplace_back(worker);
+        worker();
+        for (auto& thread : threads)
+            thread.join();
+
+        if (result.found || result.timed_out)
+            break;
+    }
+
+    if (result.found)
+        result.timed_out = false;
+    return result;
+}
+
+} // namespace Bot
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "PieceShapes.h"
+#include "game/Timing.h"
+#include "game/components/PieceType.h"
+
+#include <vector>
+#include <stdint.h>
+
+
+class HoldQueue;
+class NextQueue;
+class Well;
+
+
+namespace Bot {
+
+/// One piece placement of a perfect clear plan.
+struct PerfectClearStep {
+    PieceType type; ///< the piece to place
+    PieceDirection direction; ///< the orientation to rotate the piece to
+    int8_t x; ///< the target column of the 4x4 piece grid, as in the Well
+    bool uses_hold; ///< the piece should be swapped with the hold queue first
+};
+
+struct PerfectClearResult {
+    bool found;
+    bool timed_out;
+    unsigned lines; ///< the height of the cleared area, if found
+    unsigned long long searched_nodes;
+    std::vector<PerfectClearStep> steps; ///< the placements in order, if found
+};
+
+/// Searches for a sequence of hard drop placements that empties the board
+/// using the known pieces (current, next queue and hold), without building
+/// higher than a set number of lines.
+///
+/// The search is a depth-first search over bitmask board states, with
+/// memoization of the dead ends. The first level of the search tree is
+/// distributed between threads, and the whole search stops when the time
+/// limit is reached.
+class PerfectClearSolver {
+public:
+    struct Settings {
+        unsigned max_lines; ///< maximum height of the cleared area, at most 6
+        Duration time_limit;
+        unsigned thread_count; ///< 0 means the number of hardware threads
+
+        Settings()
+            : max_lines(4)
+            , time_limit(std::chrono::milliseconds(50))
+            , thread_count(0)
+        {}
+    };
+
+    /// Create a solver with the piece shapes of the current rotation system
+    PerfectClearSolver(Settings settings = Settings());
+
+    /// Search for a perfect clear in the current state of a player's game
+    PerfectClearResult solve(const Well&, const NextQueue&, const HoldQueue&) const;
+
+    /// Search for a perfect clear.
+    /// `rows` are the occupied cells of the board from the bottom row upwards,
+    /// with the leftmost column in the lowest bit. `pieces` starts with the
+    /// currently controlled piece. `hold` is only used if `has_hold` is set.
+    PerfectClearResult solve(const std::vector<uint16_t>& rows,
+                             const std::vector<PieceType>& pieces,
+                             bool has_hold, PieceType hold) const;
+
+private:
+    const Settings settings;
+    const PieceShapes shapes;
+};
+
+} // namespace Bot
@@ -0,0 +1,58 @@
+#include "PieceShapes.h"
+
+#include "game/components/PieceFactory.h"
+
+#include <algorithm>
+#include <assert.h>
+
+
+namespace Bot {
+
+PieceShapes::PieceShapes()
+{
+    for (const PieceType type : PieceTypeList) {
+        const auto& grids = PieceFactory::initialPositions(type);
+        auto& type_shapes = shapes[static_cast<size_t>(type)];
+
+        for (size_t frame = 0; frame < 4; frame++) {
+            // read the 4x4 grid, see Piece's constructor for the bit layout
+            std::array<uint16_t, 4> grid_rows = {{0, 0, 0, 0}};
+            for (size_t i = 0; i < 16; i++) {
+                if (grids[frame].test(15 - i))
+                    grid_rows[i / 4] |= 1 << (i % 4);
+            }
+
+            uint8_t top = 4, bottom = 0, left = 4, right = 0;
+            for (uint8_t row = 0; row < 4; row++) {
+                for (uint8_t col = 0; col < 4; col++) {
+                    if (grid_rows[row] & (1 << col)) {
+                        top = std::min(top, row);
+                        bottom = std::max(bottom, row);
+                        left = std::min(left, col);
+                        right = std::max(right, col);
+                    }
+                }
+            }
+            assert(top <= bottom && left <= right);
+
+            PieceShape& shape = type_shapes[frame];
+            shape.rows = {{0, 0, 0, 0}};
+            for (uint8_t row = top; row <= bottom; row++)
+                shape.rows[row - top] = grid_rows[row] >> left;
+            shape.width = right - left + 1;
+            shape.height = bottom - top + 1;
+            shape.grid_col = left;
+            shape.grid_row = top;
+
+            shape.duplicate = false;
+            for (size_t prev = 0; prev < frame; prev++) {
+                if (type_shapes[prev].rows == shape.rows) {
+                    shape.duplicate = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+} // namespace Bot
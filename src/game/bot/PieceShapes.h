@@ -0,0 +1,38 @@
+#pragma once
+
+#include "game/components/PieceType.h"
+
+#include <array>
+#include <stdint.h>
+
+
+namespace Bot {
+
+/// The cells of a piece in one orientation, as row bitmasks.
+/// The masks are aligned to the left edge of the piece, and the
+/// leftmost column is stored in the lowest bit.
+struct PieceShape {
+    std::array<uint16_t, 4> rows; ///< top row first
+    uint8_t width;
+    uint8_t height;
+    uint8_t grid_col; ///< the column of the leftmost cell in the 4x4 piece grid
+    uint8_t grid_row; ///< the row of the topmost cell in the 4x4 piece grid
+    bool duplicate; ///< true if an earlier orientation has the same cells
+};
+
+/// Bitmask representation of every piece in every orientation,
+/// built from the grids of the current rotation system.
+class PieceShapes {
+public:
+    /// Build the shapes from the initial positions of the PieceFactory
+    PieceShapes();
+
+    const PieceShape& get(PieceType type, PieceDirection dir) const {
+        return shapes[static_cast<size_t>(type)][static_cast<size_t>(dir)];
+    }
+
+private:
+    std::array<std::array<PieceShape, 4>, PieceTypeList.size()> shapes;
+};
+
+} // namespace Bot
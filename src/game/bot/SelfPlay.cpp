@@ -0,0 +1,319 @@
+#include "SelfPlay.h"
+
+#include "Board.h"
+#include "DatasetWriter.h"
+#include "game/ScoreTable.h"
+#include "game/components/randomizers/Randomizer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <cstdlib>
+#include <deque>
+#include <limits>
+#include <random>
+#include <thread>
+#include <assert.h>
+
+
+namespace Bot {
+
+namespace {
+constexpr float weight_height = -0.51f;
+constexpr float weight_lines = 0.76f;
+constexpr float weight_holes = -0.36f;
+constexpr float weight_bumpiness = -0.18f;
+constexpr float weight_attack = 0.5f;
+
+template <typename Policy>
+struct Player {
+    Board board;
+    Randomizers::Generator<Policy> randomizer;
+    std::deque<PieceType> queue; ///< the current piece and the previews
+    bool has_hold;
+    PieceType hold;
+    unsigned pending_garbage;
+    ScoreType previous_lineclear;
+    bool lost;
+    std::vector<DatasetRecord> records;
+
+    explicit Player(uint32_t piece_seed)
+        : randomizer(piece_seed)
+        , has_hold(false)
+        , hold(PieceType::I)
+        , pending_garbage(0)
+        , previous_lineclear(ScoreType::CLEAR_SINGLE)
+        , lost(false)
+    {
+        while (queue.size() < DatasetRecord::queue_length)
+            queue.push_back(randomizer.next());
+    }
+};
+
+float evaluate(const Board& board, unsigned cleared_lines, unsigned sent_lines)
+{
+    std::array<unsigned, Board::width> heights = {};
+    unsigned holes = 0;
+    uint16_t covered = 0;
+    for (unsigned row = board.stackHeight(); row-- > 0;) {
+        const uint16_t cells = board.row(row);
+        holes += std::bitset<16>(covered & ~cells).count();
+        covered |= cells;
+        for (unsigned col = 0; col < Board::width; col++) {
+            if (!heights[col] && (cells & (1 << col)))
+                heights[col] = row + 1;
+        }
+    }
+
+    unsigned aggregate_height = heights[0];
+    unsigned bumpiness = 0;
+    for (unsigned col = 1; col < Board::width; col++) {
+        aggregate_height += heights[col];
+        bumpiness += std::abs(static_cast<int>(heights[col]) - static_cast<int>(heights[col - 1]));
+    }
+
+    return weight_height * aggregate_height
+         + weight_lines * cleared_lines
+         + weight_holes * holes
+         + weight_bumpiness * bumpiness
+         + weight_attack * sent_lines;
+}
+
+bool isToppedOut(const Board& board)
+{
+    return board.stackHeight() > Board::spawn_row;
+}
+
+/// Plays games on one thread
+class GameRunner {
+public:
+    GameRunner(const SelfPlay::Settings& settings, const PieceShapes& shapes)
+        : settings(settings)
+        , shapes(shapes)
+    {}
+
+    /// Play a game, and return the records of every player
+    std::vector<DatasetRecord> play(uint32_t game_id, bool& has_winner)
+    {
+        using namespace Randomizers;
+
+        switch (settings.randomizer) {
+            case RandomizerType::BAG7: return playGame<Bag7>(game_id, has_winner);
+            case RandomizerType::BAG14: return playGame<Bag14>(game_id, has_winner);
+            case RandomizerType::PURE_RANDOM: return playGame<PureRandom>(game_id, has_winner);
+            case RandomizerType::TGM_HISTORY: return playGame<TGMHistory>(game_id, has_winner);
+            case RandomizerType::BAG7_PLUS1: return playGame<Bag7Plus1>(game_id, has_winner);
+        }
+
+        assert(false);
+        return {};
+    }
+
+private:
+    const SelfPlay::Settings& settings;
+    const PieceShapes& shapes;
+    std::mt19937 rng;
+    std::vector<Placement> candidates;
+
+    template <typename Policy>
+    std::vector<DatasetRecord> playGame(uint32_t game_id, bool& has_winner)
+    {
+        std::seed_seq game_seed {settings.seed, game_id};
+        std::array<uint32_t, 2> seeds;
+        game_seed.generate(seeds.begin(), seeds.end());
+        rng.seed(seeds[0]);
+
+        // every player gets the same piece sequence
+        std::vector<Player<Policy>> players(settings.versus ? 2 : 1, Player<Policy>(seeds[1]));
+
+        unsigned moves = 0;
+        bool game_over = false;
+        while (!game_over && moves < settings.max_moves) {
+            for (unsigned idx = 0; idx < players.size(); idx++) {
+                Player<Policy>* opponent = players.size() > 1 ? &players[1 - idx] : nullptr;
+                playMove(game_id, idx, players[idx], opponent, moves);
+                if (players[idx].lost) {
+                    game_over = true;
+                    break;
+                }
+            }
+            moves++;
+        }
+
+        has_winner = game_over && players.size() > 1;
+        std::vector<DatasetRecord> records;
+        for (auto& player : players) {
+            int8_t outcome = 0;
+            if (player.lost)
+                outcome = -1;
+            else if (has_winner)
+                outcome = 1;
+
+            const unsigned move_count = player.records.size();
+            for (auto& record : player.records) {
+                record.outcome = outcome;
+                record.moves_left = move_count - record.move;
+            }
+            records.insert(records.end(), player.records.begin(), player.records.end());
+        }
+        return records;
+    }
+
+    unsigned sendableLines(ScoreType previous_lineclear, unsigned cleared_lines, ScoreType& clear_type) const
+    {
+        if (!cleared_lines)
+            return 0;
+
+        WellEvent::lineclear_t lineclear;
+        lineclear.count = cleared_lines;
+        lineclear.type = LineClearType::NORMAL;
+        const ScoreRules& rules = ScoreTable::rules(ScoreRuleSet::GUIDELINE);
+        clear_type = ScoreTable::lineclearType(lineclear);
+        const bool back2back = rules.canContinueBackToBack(previous_lineclear, clear_type);
+        return rules.sendableLineCount(clear_type, back2back);
+    }
+
+    template <typename Policy>
+    void playMove(uint32_t game_id, unsigned player_idx, Player<Policy>& player, Player<Policy>* opponent,
+                  unsigned move)
+    {
+        const PieceType current = player.queue.front();
+        const PieceType alternative = player.has_hold ? player.hold : player.queue.at(1);
+
+        candidates.clear();
+        auto add_candidate = [this](const Placement& placement){ candidates.push_back(placement); };
+        player.board.forEachPlacement(shapes, current, false, add_candidate);
+        if (alternative != current)
+            player.board.forEachPlacement(shapes, alternative, true, add_candidate);
+
+        if (candidates.empty()) {
+            player.lost = true;
+            return;
+        }
+
+        // choose a placement
+        size_t chosen = 0;
+        if (std::generate_canonical<float, 24>(rng) < settings.randomness) {
+            chosen = std::uniform_int_distribution<size_t>(0, candidates.size() - 1)(rng);
+        }
+        else {
+            float best_score = std::numeric_limits<float>::lowest();
+            for (size_t i = 0; i < candidates.size(); i++) {
+                Board result = player.board;
+                const unsigned cleared = result.place(shapes, candidates[i]);
+                ScoreType clear_type;
+                const unsigned sent = sendableLines(player.previous_lineclear, cleared, clear_type);
+                const float score = isToppedOut(result)
+                    ? std::numeric_limits<float>::lowest()
+                    : evaluate(result, cleared, sent);
+                if (score > best_score) {
+                    best_score = score;
+                    chosen = i;
+                }
+            }
+        }
+        const Placement& placement = candidates[chosen];
+
+        // save the state before the move
+        DatasetRecord record;
+        record.game_id = game_id;
+        record.move = move;
+        record.player = player_idx;
+        std::copy_n(player.board.allRows().begin(), record.board.size(), record.board.begin());
+        for (unsigned i = 0; i < record.queue.size(); i++)
+            record.queue[i] = static_cast<uint8_t>(player.queue[i]);
+        record.hold = player.has_hold ? static_cast<uint8_t>(player.hold) : DatasetRecord::no_piece;
+        record.pending_garbage = std::min(player.pending_garbage, 0xFFu);
+        record.placement_type = static_cast<uint8_t>(placement.type);
+        record.placement_direction = static_cast<uint8_t>(placement.direction);
+        record.placement_x = placement.x;
+        record.placement_row = placement.row;
+        record.placement_uses_hold = placement.uses_hold;
+        record.outcome = 0;
+        record.moves_left = 0;
+
+        // apply the move
+        if (placement.uses_hold) {
+            if (!player.has_hold)
+                player.queue.pop_front();
+            player.hold = current;
+            player.has_hold = true;
+        }
+        player.queue.pop_front();
+        while (player.queue.size() < DatasetRecord::queue_length)
+            player.queue.push_back(player.randomizer.next());
+
+        const unsigned cleared = player.board.place(shapes, placement);
+        ScoreType clear_type = player.previous_lineclear;
+        unsigned sent = sendableLines(player.previous_lineclear, cleared, clear_type);
+        player.previous_lineclear = clear_type;
+
+        record.cleared_lines = cleared;
+        record.sent_lines = std::min(sent, 0xFFu);
+        player.records.push_back(record);
+
+        // the attack first reduces the incoming garbage
+        const unsigned cancelled = std::min(sent, player.pending_garbage);
+        player.pending_garbage -= cancelled;
+        sent -= cancelled;
+        if (opponent)
+            opponent->pending_garbage += sent;
+
+        // the rest of the garbage arrives if the piece didn't clear lines
+        if (!cleared && player.pending_garbage) {
+            const unsigned hole = std::uniform_int_distribution<unsigned>(0, Board::width - 1)(rng);
+            player.board.addGarbageLines(player.pending_garbage, hole);
+            player.pending_garbage = 0;
+        }
+
+        player.lost = isToppedOut(player.board);
+    }
+};
+} // namespace
+
+
+SelfPlay::SelfPlay(Settings settings)
+    : settings(settings)
+{
+    assert(settings.max_moves <= std::numeric_limits<uint16_t>::max());
+}
+
+SelfPlayStats SelfPlay::run(DatasetWriter& writer) const
+{
+    const auto start_time = std::chrono::steady_clock::now();
+    const unsigned thread_count = settings.thread_count
+        ? settings.thread_count
+        : std::max(1u, std::thread::hardware_concurrency());
+
+    std::atomic<unsigned> next_game(0);
+    std::atomic<unsigned long long> positions(0);
+    std::atomic<unsigned long long> wins(0);
+
+    auto worker = [&](){
+        GameRunner runner(settings, shapes);
+        unsigned game_id;
+        while ((game_id = next_game++) < settings.game_count) {
+            bool has_winner = false;
+            auto records = runner.play(game_id, has_winner);
+            positions += records.size();
+            wins += has_winner;
+            writer.push(std::move(records));
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < std::min(thread_count, settings.game_count); i++)
+        threads.emplace_back(worker);
+    worker();
+    for (auto& thread : threads)
+        thread.join();
+
+    SelfPlayStats stats;
+    stats.games = settings.game_count;
+    stats.positions = positions;
+    stats.wins = wins;
+    stats.duration = std::chrono::duration_cast<Duration>(std::chrono::steady_clock::now() - start_time);
+    return stats;
+}
+
+} // namespace Bot
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "PieceShapes.h"
+#include "game/Timing.h"
+#include "game/components/randomizers/RandomizerType.h"
+
+#include <stdint.h>
+
+
+namespace Bot {
+
+class DatasetWriter;
+
+struct SelfPlayStats {
+    unsigned long long games;
+    unsigned long long positions;
+    unsigned long long wins; ///< versus games with a winner
+    Duration duration;
+};
+
+/// Plays bot-solo or bot-vs-bot games without a window, and sends every
+/// decision of the bots to a DatasetWriter.
+///
+/// The games are simplified simulations: pieces are placed with hard drops
+/// only, and in versus mode the players take turns placing one piece each.
+/// The bots choose their moves using a board evaluation heuristic, with
+/// some randomness for variety. Every game is seeded from the base seed
+/// and the game index, so the output is reproducible.
+class SelfPlay {
+public:
+    struct Settings {
+        unsigned game_count;
+        unsigned thread_count; ///< 0 means the number of hardware threads
+        bool versus;
+        unsigned max_moves; ///< per player, after which the game is a draw
+        uint32_t seed;
+        float randomness; ///< the chance of choosing a random move
+        RandomizerType randomizer;
+
+        Settings()
+            : game_count(1000)
+            , thread_count(0)
+            , versus(false)
+            , max_moves(1000)
+            , seed(0)
+            , randomness(0.05f)
+            , randomizer(RandomizerType::BAG7)
+        {}
+    };
+
+    /// Create a runner with the piece shapes of the current rotation system
+    SelfPlay(Settings settings = Settings());
+
+    /// Play every game, and push the records of each finished game to the writer
+    SelfPlayStats run(DatasetWriter&) const;
+
+private:
+    const Settings settings;
+    const PieceShapes shapes;
+};
+
+} // namespace Bot
@@ -1,7 +1,7 @@
 #include "HoldQueue.h"
 
 #include "Mino.h"
-#include "PieceFactory.h"
+#include "PiecePreviews.h"
 #include "game/Timing.h"
 #include "system/GraphicsContext.h"
 
@@ -18,12 +18,6 @@ HoldQueue::HoldQueue()
         [this](){ this->swapblocked_alpha.stop(); })
 {
     swapblocked_alpha.stop();
-
-    size_t i = 0;
-    for(const auto ptype : PieceTypeList) {
-        piece_storage[i] = PieceFactory::make_uptr(ptype);
-        i++;
-    }
 }
 
 HoldQueue::~HoldQueue() = default;
@@ -80,10 +74,6 @@ void HoldQueue::draw(GraphicsContext& gcx, int x, int y) const
             {0xFF, 0x0, 0x0, swapblocked_alpha.value()});
     }
 
-    if (!empty) {
-        const auto& piece = piece_storage.at(static_cast<size_t>(current_piece));
-        const float padding_x = (4 - Piece::displayWidth(piece->type())) / 2.0f;
-        piece->draw(x + Mino::texture_size_px * (0.5f + padding_x),
-                    y + Mino::texture_size_px);
-    }
+    if (!empty)
+        PiecePreviews::draw(current_piece, PiecePreviews::Size::NORMAL, x, y + Mino::texture_size_px);
 }
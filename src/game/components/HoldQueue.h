@@ -9,7 +9,6 @@
 
 
 class GraphicsContext;
-class Piece;
 
 
 /// A piece holder, allows swapping the active piece once in every turn.
@@ -29,6 +28,8 @@ public:
 
     /// True, if the holder is empty.
     bool isEmpty() const { return empty; }
+    /// Returns the currently held piece. Only meaningful if the holder is not empty.
+    PieceType heldPiece() const { return current_piece; }
 
     /// Returns the currently held piece, and replaces it with the specified one.
     PieceType swapWith(PieceType);
@@ -44,7 +45,6 @@ private:
     bool swap_allowed;
     bool empty;
     PieceType current_piece;
-    std::array<std::unique_ptr<Piece>, 7> piece_storage;
 
     Transition<uint8_t> swapblocked_alpha;
 };
@@ -3,8 +3,9 @@
 #include <assert.h>
 
 
-Mino::Mino(std::unique_ptr<Texture> texture, char ascii_val)
+Mino::Mino(std::shared_ptr<Texture> texture, const Rectangle& region, char ascii_val)
     : texture(std::move(texture))
+    , region(region)
     , ascii_val(ascii_val)
 {
 }
@@ -12,11 +13,16 @@ Mino::Mino(std::unique_ptr<Texture> texture, char ascii_val)
 void Mino::draw(int x, int y)
 {
     assert(texture);
-    texture->drawScaled({x, y, texture_size_px, texture_size_px});
+    texture->drawPartialScaled(region, {x, y, texture_size_px, texture_size_px});
 }
 
 void Mino::drawPartial(const Rectangle& from, const Rectangle& to)
 {
     assert(texture);
-    texture->drawPartialScaled(from, to);
+    texture->drawPartialScaled({
+        region.x + from.x * region.w / texture_size_px,
+        region.y + from.y * region.h / texture_size_px,
+        from.w * region.w / texture_size_px,
+        from.h * region.h / texture_size_px,
+    }, to);
 }
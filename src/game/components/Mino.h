@@ -9,12 +9,13 @@
 /// A Mino represents one block of a piece.
 class Mino {
 public:
-    /// Create a mino with the texture and Ascii value
-    Mino(std::unique_ptr<Texture> texture, char ascii_val);
+    /// Create a mino with a region of a (possibly shared) texture and the Ascii value
+    Mino(std::shared_ptr<Texture> texture, const Rectangle& region, char ascii_val);
 
     /// Draw the Mino at the provided coordinates
     void draw(int x, int y);
-    /// Draw part of the Mino texture to the provided area
+    /// Draw part of the Mino to the provided area; `from` is relative
+    /// to the Mino, in the range of `texture_size_px`
     void drawPartial(const Rectangle& from, const Rectangle& to);
     /// The Ascii value of the Mino, used mainly for debugging
     char asAscii() const { return ascii_val; }
@@ -23,6 +24,7 @@ public:
     static constexpr int8_t texture_size_px = 32;
 
 private:
-    const std::unique_ptr<Texture> texture;
+    const std::shared_ptr<Texture> texture;
+    const Rectangle region;
     const char ascii_val;
 };
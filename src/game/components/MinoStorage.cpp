@@ -5,6 +5,7 @@
 #include "system/GraphicsContext.h"
 
 #include <stdexcept>
+#include <vector>
 #include <assert.h>
 
 
@@ -16,30 +17,16 @@ std::shared_ptr<Mino> MinoStorage::matrixcell;
 void MinoStorage::loadDummyMinos()
 {
     for (const auto& type : PieceTypeList) {
-        minos[type] = std::make_shared<Mino>(nullptr, ::toAscii(type));
-        ghosts[type] = std::make_shared<Mino>(nullptr, 'g');
+        minos[type] = std::make_shared<Mino>(nullptr, Rectangle(), ::toAscii(type));
+        ghosts[type] = std::make_shared<Mino>(nullptr, Rectangle(), 'g');
     }
-    minos[PieceType::GARBAGE] = std::make_shared<Mino>(nullptr, ::toAscii(PieceType::GARBAGE));
+    minos[PieceType::GARBAGE] = std::make_shared<Mino>(nullptr, Rectangle(), ::toAscii(PieceType::GARBAGE));
     matrixcell.reset();
 }
 #endif
 
-void MinoStorage::loadMinos(AppContext& app)
-{
-    if (app.theme().gameplay.custom_minos)
-        loadCustomMinos(app);
-    else
-        loadTintedMinos(app.gcx(), app.theme().get_texture("mino.png"));
-}
-
-void MinoStorage::loadTintedMinos(GraphicsContext& gcx, const std::string& path)
-{
-    minos[PieceType::GARBAGE] = std::make_shared<Mino>(gcx.loadTexture(path), ::toAscii(PieceType::GARBAGE));
-    for (const auto& type : PieceTypeList)
-        minos[type] = std::make_shared<Mino>(gcx.loadTexture(path, color(type)), ::toAscii(type));
-}
-
-void MinoStorage::loadCustomMinos(AppContext& app)
+namespace {
+std::string customMinoPath(const ThemeConfig& theme, PieceType type)
 {
     static const std::unordered_map<PieceType, const std::string, PieceTypeHash> suffixes = {
         { PieceType::I, "i" },
@@ -51,45 +38,54 @@ void MinoStorage::loadCustomMinos(AppContext& app)
         { PieceType::Z, "z" },
         { PieceType::GARBAGE, "garbage" },
     };
-    for (const auto& pair : suffixes) {
-        const PieceType type = pair.first;
-        try {
-            const std::string path = app.theme().get_texture("mino_" + pair.second + ".png");
-            minos[type] = std::make_shared<Mino>(app.gcx().loadTexture(path), ::toAscii(type));
-        }
-        catch (const std::runtime_error& err) {
-            // fallback to regular mino
-            minos[type] = std::make_shared<Mino>(app.gcx().loadTexture(
-                app.theme().get_texture("mino.png")), ::toAscii(type));
-        }
+    try {
+        return theme.get_texture("mino_" + suffixes.at(type) + ".png");
+    }
+    catch (const std::runtime_error& err) {
+        // fallback to regular mino
+        return theme.get_texture("mino.png");
     }
 }
+} // namespace
 
-void MinoStorage::loadGhosts(AppContext& app)
+void MinoStorage::loadTextures(AppContext& app)
 {
-    const auto path = app.theme().get_texture("ghost.png");
-
-    if (app.theme().gameplay.tint_ghost)
-        loadTintedGhosts(app.gcx(), path);
-    else
-        loadSimpleGhosts(app.gcx(), path);
-}
+    const auto& theme = app.theme();
+    const RGBColor no_tint = 0xFFFFFF_rgb;
+
+    // the order of the images: the minos, the garbage, the ghosts, then the matrix cell
+    std::vector<AtlasImage> images;
+    if (theme.gameplay.custom_minos) {
+        for (const auto& type : PieceTypeList)
+            images.push_back({customMinoPath(theme, type), no_tint});
+        images.push_back({customMinoPath(theme, PieceType::GARBAGE), no_tint});
+    }
+    else {
+        const auto path = theme.get_texture("mino.png");
+        for (const auto& type : PieceTypeList)
+            images.push_back({path, color(type)});
+        images.push_back({path, no_tint});
+    }
 
-void MinoStorage::loadTintedGhosts(GraphicsContext& gcx, const std::string& path)
-{
+    const auto ghost_path = theme.get_texture("ghost.png");
     for (const auto& type : PieceTypeList)
-        ghosts[type] = std::make_shared<Mino>(gcx.loadTexture(path, color(type)), 'g');
-}
+        images.push_back({ghost_path, theme.gameplay.tint_ghost ? color(type) : no_tint});
 
-void MinoStorage::loadSimpleGhosts(GraphicsContext& gcx, const std::string& path)
-{
-    for (const auto& type : PieceTypeList)
-        ghosts[type] = std::make_shared<Mino>(gcx.loadTexture(path), 'g');
-}
+    images.push_back({theme.get_texture("matrix.png"), no_tint});
 
-void MinoStorage::loadMatrixCell(GraphicsContext& gcx, const std::string& path)
-{
-    matrixcell = std::make_shared<Mino>(gcx.loadTexture(path), '.');
+
+    std::vector<Rectangle> regions;
+    const std::shared_ptr<Texture> atlas = app.gcx().loadTextureAtlas(images, regions);
+    assert(regions.size() == images.size());
+
+    auto region = regions.cbegin();
+    for (const auto& type : PieceTypeList)
+        minos[type] = std::make_shared<Mino>(atlas, *(region++), ::toAscii(type));
+    minos[PieceType::GARBAGE] = std::make_shared<Mino>(atlas, *(region++), ::toAscii(PieceType::GARBAGE));
+    for (const auto& type : PieceTypeList)
+        ghosts[type] = std::make_shared<Mino>(atlas, *(region++), 'g');
+    matrixcell = std::make_shared<Mino>(atlas, *(region++), '.');
+    assert(region == regions.cend());
 }
 
 std::shared_ptr<Mino> MinoStorage::getMino(PieceType type)
@@ -7,15 +7,15 @@
 #include <unordered_map>
 
 class AppContext;
-class GraphicsContext;
 class Mino;
 
 
 class MinoStorage {
 public:
-    static void loadMinos(AppContext&);
-    static void loadGhosts(AppContext&);
-    static void loadMatrixCell(GraphicsContext&, const std::string&);
+    /// Load the minos, the ghosts and the matrix cell of the current theme.
+    /// All of them are packed into a single texture atlas, so the wells can be
+    /// drawn without texture switches.
+    static void loadTextures(AppContext&);
 
     static std::shared_ptr<Mino> getMino(PieceType);
     static std::shared_ptr<Mino> getGhost(PieceType);
@@ -28,10 +28,6 @@ public:
 #endif
 
 private:
-    static void loadTintedMinos(GraphicsContext&, const std::string&);
-    static void loadCustomMinos(AppContext&);
-    static void loadTintedGhosts(GraphicsContext&, const std::string&);
-    static void loadSimpleGhosts(GraphicsContext&, const std::string&);
     static std::unordered_map<PieceType, std::shared_ptr<Mino>, PieceTypeHash> minos;
     static std::unordered_map<PieceType, std::shared_ptr<Mino>, PieceTypeHash> ghosts;
     static std::shared_ptr<Mino> matrixcell;
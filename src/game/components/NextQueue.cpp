@@ -1,99 +1,92 @@
 #include "NextQueue.h"
 
-#include "PieceFactory.h"
-#include "system/GraphicsContext.h"
+#include "Mino.h"
+#include "PiecePreviews.h"
 
 #include <algorithm>
 #include <array>
+#include <cstdlib>
 #include <assert.h>
 
 
-std::deque<PieceType> NextQueue::global_piece_queue = {};
+constexpr unsigned NextQueue::max_preview_count;
+uint32_t NextQueue::sequence_seed = 0;
+unsigned NextQueue::instance_count = 0;
 
-NextQueue::NextQueue(unsigned displayed_piece_count)
-    : displayed_piece_count(displayed_piece_count)
+NextQueue::NextQueue(unsigned displayed_piece_count, RandomizerType randomizer_type)
+    : displayed_piece_count(std::min(displayed_piece_count, max_preview_count))
 {
-    if (global_piece_queue.size() <= displayed_piece_count)
-        generate_global_pieces();
-
-    global_queue_it = global_piece_queue.cbegin();
-    piece_queue = global_piece_queue;
+    // NOTE: next queues are created and destructed together
+    if (instance_count++ == 0)
+        sequence_seed = std::rand();
 
-    size_t i = 0;
-    for(const auto ptype : PieceTypeList) {
-        piece_storage[i] = PieceFactory::make_uptr(ptype);
-        i++;
-    }
+    setRandomizer(randomizer_type);
 }
 
 NextQueue::~NextQueue()
 {
-    // NOTE: next queues are created and destructed together
-    global_piece_queue.clear();
+    assert(instance_count > 0);
+    instance_count--;
+}
+
+void NextQueue::setRandomizer(RandomizerType randomizer_type)
+{
+    randomizer = RandomizerFactory::make(randomizer_type, sequence_seed);
+    block_size = 0;
+    block_pos = 0;
+    ring_head = 0;
+    ring_size = 0;
+    fill_queue();
 }
 
 PieceType NextQueue::next()
 {
-    PieceType piece = piece_queue.front();
-    piece_queue.pop_front();
+    assert(ring_size > 0);
+    PieceType piece = piece_ring[ring_head];
+    ring_head = (ring_head + 1) % piece_ring.size();
+    ring_size--;
     fill_queue();
     return piece;
 }
 
-void NextQueue::generate_global_pieces()
+PieceType NextQueue::preview(unsigned i) const
 {
-    std::array<PieceType, PieceTypeList.size()> possible_pieces = PieceTypeList;
-    std::random_shuffle(possible_pieces.begin(), possible_pieces.end());
-    for (const auto p : possible_pieces)
-        global_piece_queue.push_back(p);
+    assert(i < ring_size);
+    return piece_ring[(ring_head + i) % piece_ring.size()];
 }
 
 void NextQueue::fill_queue()
 {
-    if (piece_queue.size() <= displayed_piece_count) {
-        if (std::distance(global_queue_it, global_piece_queue.cend()) <= static_cast<int>(PieceTypeList.size()))
-            generate_global_pieces();
-
-        piece_queue.insert(piece_queue.end(),
-                           global_queue_it,
-                           global_queue_it + PieceTypeList.size());
-        global_queue_it += PieceTypeList.size();
+    while (ring_size <= displayed_piece_count) {
+        if (block_pos == block_size) {
+            block_size = randomizer->nextBlock(block.data());
+            block_pos = 0;
+        }
+        piece_ring[(ring_head + ring_size) % piece_ring.size()] = block[block_pos++];
+        ring_size++;
     }
-    assert(piece_queue.size() > displayed_piece_count);
+    assert(ring_size > displayed_piece_count);
 }
 
 void NextQueue::setPreviewCount(unsigned num)
 {
-    displayed_piece_count = num;
+    displayed_piece_count = std::min(num, max_preview_count);
     fill_queue();
 }
 
-void NextQueue::draw(GraphicsContext& gcx, int x, int y) const
+void NextQueue::draw(GraphicsContext&, int x, int y) const
 {
     if (!displayed_piece_count)
         return;
 
     int offset_y = y + Mino::texture_size_px;
-    draw_nth_piece(0, x, offset_y);
+    PiecePreviews::draw(preview(0), PiecePreviews::Size::NORMAL, x, offset_y);
     offset_y += Mino::texture_size_px * 3;
 
-    const auto scale = gcx.getDrawScale();
-    gcx.modifyDrawScale(scale * 0.75);
-    x *= (1 / 0.75);
-    offset_y *= (1 / 0.75);
-    offset_y += Mino::texture_size_px;
+    const float small_mino_size = Mino::texture_size_px * PiecePreviews::scale(PiecePreviews::Size::SMALL);
+    offset_y += small_mino_size;
     for (unsigned i = 1; i < displayed_piece_count; i++) {
-        draw_nth_piece(i, x, offset_y);
-        offset_y += Mino::texture_size_px * 3;
+        PiecePreviews::draw(preview(i), PiecePreviews::Size::SMALL, x, offset_y);
+        offset_y += small_mino_size * 3;
     }
-    gcx.modifyDrawScale(scale);
-}
-
-void NextQueue::draw_nth_piece(unsigned i, int x, int y) const
-{
-    assert(i < piece_queue.size());
-    assert(i < displayed_piece_count);
-    const auto& piece = piece_storage.at(static_cast<size_t>(piece_queue.at(i)));
-    const float padding_x = (4 - Piece::displayWidth(piece->type())) / 2.0f;
-    piece->draw(x + Mino::texture_size_px * (0.5f + padding_x), y);
 }
@@ -1,40 +1,63 @@
 #pragma once
 
 #include "PieceType.h"
+#include "randomizers/Randomizer.h"
 #include "system/Color.h"
 
-#include <deque>
+#include <array>
 #include <memory>
+#include <stdint.h>
 
 
 class GraphicsContext;
-class Piece;
 
 /// Produces the next piece randomly, and allows to preview
 /// the next N pieces.
 class NextQueue {
 public:
+    /// The maximum number of previewable pieces
+    static constexpr unsigned max_preview_count = 15;
+
     /// Create a piece queue and allow previewing the next N pieces.
-    NextQueue(unsigned displayed_piece_count = 1);
+    NextQueue(unsigned displayed_piece_count = 1, RandomizerType = RandomizerType::BAG7);
     ~NextQueue();
 
+    /// Restart the piece sequence with a different randomizer.
+    /// Should be called before the game starts.
+    void setRandomizer(RandomizerType);
+
+    /// The seed of the current game's piece sequence, shared by every queue.
+    static uint32_t sequenceSeed() { return sequence_seed; }
+
     /// Pop the top of the queue.
     PieceType next();
     void setPreviewCount(unsigned);
+    /// The number of previewable pieces
+    unsigned previewCount() const { return displayed_piece_count; }
+    /// Returns the Nth upcoming piece, without removing it from the queue.
+    PieceType preview(unsigned i) const;
 
     /// Draw the N previewable pieces at (x,y)
     void draw(GraphicsContext&, int x, int y) const;
 
 private:
-    static std::deque<PieceType> global_piece_queue;
-    std::deque<PieceType>::const_iterator global_queue_it;
-    std::deque<PieceType> piece_queue;
-    std::array<std::unique_ptr<Piece>, 7> piece_storage;
+    // When there are multiple players, we want to provide
+    // the same order of pieces for all of them. Every queue has
+    // its own randomizer, seeded by a value shared by every queue,
+    // and a new seed is chosen when the first queue of a game is created.
+    static uint32_t sequence_seed;
+    static unsigned instance_count;
+
+    std::unique_ptr<Randomizer> randomizer;
+    std::array<PieceType, Randomizers::max_block_size> block;
+    unsigned block_size;
+    unsigned block_pos;
+
+    std::array<PieceType, max_preview_count + 1> piece_ring;
+    unsigned ring_head;
+    unsigned ring_size;
+
     unsigned displayed_piece_count;
 
-    // When there are multiple players, we want to provide
-    // the same order of pieces for all of them.
-    void generate_global_pieces();
     void fill_queue();
-    void draw_nth_piece(unsigned i, int x, int y) const;
 };
@@ -30,6 +30,8 @@ public:
     void rotateCW();
     /// Rotate the piece counter-clockwise
     void rotateCCW();
+    /// Return to the initial (spawn) orientation
+    void resetOrientation() { current_rotation = PieceDirection::NORTH; }
     /// Read the rotation grid of the piece
     const PieceGrid& currentGrid() const;
     /// Returns the rotation grid, allowing modifications
@@ -18,3 +18,9 @@ std::unique_ptr<Piece> PieceFactory::make_uptr(PieceType type)
     assert(initial_positions.count(type));
     return std::make_unique<Piece>(type, initial_positions.at(type));
 }
+
+const std::array<std::bitset<16>, 4>& PieceFactory::initialPositions(PieceType type)
+{
+    assert(initial_positions.count(type));
+    return initial_positions.at(type);
+}
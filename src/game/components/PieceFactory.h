@@ -10,6 +10,8 @@ class PieceFactory {
 public:
     static void changeInitialPositions(std::map<PieceType, std::array<std::bitset<16>, 4>>&&);
     static std::unique_ptr<Piece> make_uptr(PieceType);
+    /// The rotation grids of a piece type in the current rotation system
+    static const std::array<std::bitset<16>, 4>& initialPositions(PieceType);
 
 private:
     static std::map<PieceType, std::array<std::bitset<16>, 4>> initial_positions;
@@ -0,0 +1,56 @@
+#include "PiecePreviews.h"
+
+#include "Mino.h"
+#include "Piece.h"
+#include "PieceFactory.h"
+#include "system/GraphicsContext.h"
+
+#include <assert.h>
+
+
+std::array<std::array<std::unique_ptr<Texture>, PieceTypeList.size()>, 2> PiecePreviews::textures;
+GraphicsContext* PiecePreviews::gcx = nullptr;
+unsigned PiecePreviews::textures_generation = 0;
+
+void PiecePreviews::render(GraphicsContext& context)
+{
+    gcx = &context;
+    for (const Size size : {Size::NORMAL, Size::SMALL}) {
+        const unsigned texture_size = 4 * Mino::texture_size_px * scale(size);
+        for (auto& texture : textures[static_cast<size_t>(size)])
+            texture = gcx->createRenderTarget(texture_size, texture_size);
+    }
+    drawTextures();
+}
+
+void PiecePreviews::drawTextures()
+{
+    assert(gcx);
+    for (const Size size : {Size::NORMAL, Size::SMALL}) {
+        const float size_scale = scale(size);
+        for (const PieceType type : PieceTypeList) {
+            const auto piece = PieceFactory::make_uptr(type);
+            auto& texture = textures[static_cast<size_t>(size)][static_cast<size_t>(type)];
+            gcx->drawIntoTexture(*texture, [&piece, size_scale](){
+                gcx->modifyDrawScale(size_scale);
+                piece->draw(0, 0);
+            });
+        }
+    }
+    textures_generation = gcx->renderTargetGeneration();
+}
+
+void PiecePreviews::draw(PieceType type, Size size, int x, int y)
+{
+    assert(type != PieceType::GARBAGE);
+    assert(gcx);
+    if (textures_generation != gcx->renderTargetGeneration())
+        drawTextures();
+
+    const auto& texture = textures[static_cast<size_t>(size)][static_cast<size_t>(type)];
+    assert(texture);
+
+    const float mino_size = Mino::texture_size_px * scale(size);
+    const float padding_x = (4 - Piece::displayWidth(type)) / 2.0f;
+    texture->drawAt(x + mino_size * (0.5f + padding_x), y);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "PieceType.h"
+
+#include <array>
+#include <memory>
+#include <stdint.h>
+
+class GraphicsContext;
+class Texture;
+
+
+/// Pre-rendered images of the pieces, as they appear in the next and hold
+/// queues, so a preview can be drawn with one draw call.
+class PiecePreviews {
+public:
+    enum class Size : uint8_t {
+        NORMAL,
+        SMALL, ///< 75% of the normal size
+    };
+
+    /// Render the piece images using the current minos.
+    /// Should be called again when the minos change.
+    static void render(GraphicsContext&);
+
+    /// Draw a piece, horizontally centered in a 5 minos wide box at (x,y).
+    /// The top row of the piece will be at y. The images are rendered again
+    /// if the render targets were reset since.
+    static void draw(PieceType, Size, int x, int y);
+
+    static float scale(Size size) { return size == Size::NORMAL ? 1.0f : 0.75f; }
+
+private:
+    static std::array<std::array<std::unique_ptr<Texture>, PieceTypeList.size()>, 2> textures;
+    static GraphicsContext* gcx; ///< the context of the textures
+    static unsigned textures_generation; ///< the render target generation of the textures
+
+    static void drawTextures();
+};
@@ -3,9 +3,6 @@
 #include "MinoStorage.h"
 #include "Piece.h"
 #include "PieceFactory.h"
-#include "animations/CellLockAnim.h"
-#include "animations/HalfHeightLineClearAnim.h"
-#include "animations/LineClearAnim.h"
 #include "rotations/RotationFactory.h"
 #include "game/Timing.h"
 #include "game/WellConfig.h"
@@ -13,7 +10,6 @@
 #include "system/util/MakeUnique.h"
 
 #include <algorithm>
-#include <cstdlib>
 #include <assert.h>
 
 
@@ -22,11 +18,13 @@ Well::Well() : Well(WellConfig()) {}
 Well::Well(const WellConfig& config)
     : gameover(false)
     , temporal_disable_timer(Duration::zero())
+    , matrix_revision(0)
     , active_piece_x(0)
     , active_piece_y(0)
     , ghost_piece_y(0)
     , softdrop_timer(Duration::zero())
     , last_lineclear_type(LineClearType::NORMAL)
+    , observed_types(0)
     , das(Timing::frame_duration_60Hz * config.shift_normal,
           Timing::frame_duration_60Hz * config.shift_turbo)
     , lock_delay(*this, Timing::frame_duration_60Hz * config.lock_delay,
@@ -44,14 +42,9 @@ void Well::updateKeystateOnly(const std::vector<InputEvent>& events)
     input.updateKeystate(events);
 }
 
-void Well::updateAnimationsOnly()
+void Well::updateAnimationsOnly(Duration elapsed)
 {
-    for (auto& anim : animations)
-        anim->update(Timing::frame_duration);
-
-    animations.remove_if([](std::unique_ptr<WellAnimation>& animptr){
-        return !animptr->isActive();
-    });
+    animations.update(elapsed);
 }
 
 void Well::updateGameplayOnly(const std::vector<InputEvent>& events)
@@ -64,7 +57,7 @@ void Well::updateGameplayOnly(const std::vector<InputEvent>& events)
         return;
     }
 
-    if (pending_cleared_rows.size())
+    if (pending_cleared_rows.any())
         this->removeEmptyRows();
 
     if (!active_piece)
@@ -88,7 +81,7 @@ void Well::updateGameplayOnly(const std::vector<InputEvent>& events)
 void Well::update(const std::vector<InputEvent>& events)
 {
     updateKeystateOnly(events);
-    updateAnimationsOnly();
+    updateAnimationsOnly(Timing::frame_duration);
     updateGameplayOnly(events);
 }
 #endif
@@ -98,7 +91,14 @@ void Well::addPiece(PieceType type)
     // the player can only control one piece at a time
     assert(!active_piece);
 
-    active_piece = PieceFactory::make_uptr(type);
+    const auto type_idx = static_cast<size_t>(type);
+    assert(type_idx < spare_pieces.size());
+    if (spare_pieces[type_idx]) {
+        active_piece = std::move(spare_pieces[type_idx]);
+        active_piece->resetOrientation();
+    }
+    else
+        active_piece = PieceFactory::make_uptr(type);
     active_piece_x = 3;
 
     // try to place the piece in row 20, then move up if it fails
@@ -116,9 +116,21 @@ void Well::addPiece(PieceType type)
     notify(WellEvent(WellEvent::Type::GAME_OVER));
 }
 
+void Well::createSparePieces()
+{
+    for (const PieceType type : PieceTypeList) {
+        auto& piece = spare_pieces[static_cast<size_t>(type)];
+        if (!piece)
+            piece = PieceFactory::make_uptr(type);
+    }
+}
+
 void Well::deletePiece()
 {
-    active_piece.reset();
+    if (!active_piece)
+        return;
+
+    spare_pieces[static_cast<size_t>(active_piece->type())] = std::move(active_piece);
 }
 
 void Well::addGarbageLines(unsigned short line_count)
@@ -126,20 +138,50 @@ void Well::addGarbageLines(unsigned short line_count)
     if (!line_count)
         return;
 
-    std::rotate(matrix.begin(), matrix.begin() + line_count, matrix.end());
+    const size_t gap_location = std::uniform_int_distribution<size_t>(0, matrix_cols - 1)(garbage_rng);
+    std::array<uint16_t, matrix_rows> row_masks;
+    row_masks.fill(((1u << matrix_cols) - 1) & ~(1u << gap_location));
+    addGarbageRows(row_masks.data(), std::min<unsigned>(line_count, matrix_rows));
+}
+
+void Well::addGarbageRows(const uint16_t* row_masks, unsigned row_count)
+{
+    if (!row_count)
+        return;
 
-    size_t gap_location = std::rand() % 10;
-    for (size_t row = matrix.size() - line_count; row < matrix.size(); row++) {
-        auto& mx_row = matrix.at(row);
-        for (size_t col = 0; col < mx_row.size(); col++)
-            mx_row.at(col) = MinoStorage::getMino(PieceType::GARBAGE);
-        mx_row.at(gap_location).reset();
+    row_count = std::min<unsigned>(row_count, matrix.size());
+    std::rotate(matrix.begin(), matrix.begin() + row_count, matrix.end());
+
+    const auto garbage_mino = MinoStorage::getMino(PieceType::GARBAGE);
+    const size_t first_row = matrix.size() - row_count;
+    for (size_t row = first_row; row < matrix.size(); row++) {
+        const uint16_t mask = row_masks[row - first_row];
+        auto& mx_row = matrix[row];
+        for (size_t col = 0; col < mx_row.size(); col++) {
+            if (mask & (1 << col))
+                mx_row[col] = garbage_mino;
+            else
+                mx_row[col].reset();
+        }
     }
 
+    matrix_revision++;
     if (active_piece)
         calculateGhostOffset();
 }
 
+uint16_t Well::rowMask(unsigned row) const
+{
+    assert(row < matrix.size());
+
+    uint16_t mask = 0;
+    for (size_t col = 0; col < matrix[row].size(); col++) {
+        if (matrix[row][col])
+            mask |= 1 << col;
+    }
+    return mask;
+}
+
 void Well::setGravity(Duration duration)
 {
     gravity.setRate(duration);
@@ -247,9 +289,27 @@ void Well::moveDownNow()
         lockThenRequestNext(); // sonic drop manual lock
 }
 
+void Well::moveDownBy(unsigned rows)
+{
+    if (!active_piece || !rows)
+        return;
+
+    // same as calling moveDownNow() `rows` times, but the ghost position
+    // is already known, so the collision tests are not repeated
+    assert(ghost_piece_y >= active_piece_y);
+    const unsigned fall_distance = std::min<unsigned>(rows, ghost_piece_y - active_piece_y);
+    if (fall_distance) {
+        active_piece_y += fall_distance;
+        lock_delay.onDescend(*this);
+    }
+    if (fall_distance < rows && lock_delay.sonicLockPossible())
+        lockThenRequestNext(); // sonic drop manual lock
+}
+
 void Well::hardDrop()
 {
-    assert(active_piece);
+    if (!active_piece)
+        return;
 
     WellEvent harddrop_event(WellEvent::Type::HARDDROPPED);
     harddrop_event.harddrop.count = ghost_piece_y - active_piece_y;
@@ -319,7 +379,7 @@ void Well::lockThenRequestNext()
     lockAndReleasePiece();
 
     // no line clear happened
-    if (pending_cleared_rows.empty()) {
+    if (pending_cleared_rows.none()) {
         switch(tspin_type) {
             case TSpinDetectionResult::TSPIN:
                 notify(WellEvent(WellEvent::Type::TSPIN_DETECTED));
@@ -336,11 +396,11 @@ void Well::lockThenRequestNext()
     else {
         switch(tspin_type) {
             case TSpinDetectionResult::TSPIN:
-                assert(pending_cleared_rows.size() < 4);
+                assert(pending_cleared_rows.count() < 4);
                 last_lineclear_type = LineClearType::TSPIN;
                 break;
             case TSpinDetectionResult::MINI_TSPIN:
-                assert(pending_cleared_rows.size() < 4);
+                assert(pending_cleared_rows.count() < 4);
                 last_lineclear_type = LineClearType::MINI_TSPIN;
                 break;
             default:
@@ -349,7 +409,7 @@ void Well::lockThenRequestNext()
         }
 
         WellEvent clear_anim_event(WellEvent::Type::LINE_CLEAR_ANIMATION_START);
-        clear_anim_event.lineclear.count = pending_cleared_rows.size();
+        clear_anim_event.lineclear.count = pending_cleared_rows.count();
         clear_anim_event.lineclear.type = last_lineclear_type;
         notify(clear_anim_event);
     }
@@ -363,7 +423,8 @@ void Well::lockAndReleasePiece()
     assert(active_piece);
     assert(isOnGround());
 
-    std::list<std::pair<unsigned, unsigned>> pending_anims;
+    std::array<std::pair<unsigned, unsigned>, 4> pending_anims;
+    unsigned pending_anim_count = 0;
 
     for (unsigned row = 0; row < 4; row++) {
         for (unsigned cell = 0; cell < 4; cell++) {
@@ -372,28 +433,30 @@ void Well::lockAndReleasePiece()
                 active_piece_x + static_cast<int>(cell) < 0)
                 continue;
 
-            if (active_piece->currentGrid().at(row).at(cell)) {
-                matrix[active_piece_y + row][active_piece_x + cell].swap(
-                    active_piece->currentGridMut()[row][cell]
-                );
+            const auto& mino = active_piece->currentGrid().at(row).at(cell);
+            if (mino) {
+                // the piece keeps its minos, so it can be reused later
+                matrix[active_piece_y + row][active_piece_x + cell] = mino;
 
                 if (active_piece_y + row >= 20) {
-                    pending_anims.emplace_back(active_piece_y + row - 20,
-                                               active_piece_x + cell);
+                    assert(pending_anim_count < pending_anims.size());
+                    pending_anims[pending_anim_count++] = {active_piece_y + row - 20,
+                                                           active_piece_x + cell};
                 }
             }
         }
     }
 
     deletePiece();
+    matrix_revision++;
     notify(WellEvent(WellEvent::Type::PIECE_LOCKED));
 
     checkLineclear();
-    if (pending_cleared_rows.empty()) {
+    if (pending_cleared_rows.none()) {
         // To avoid graphical glitches (animations flying in the air),
         // only add cell lock animation if there was no line clear event
-        for (const auto& coord : pending_anims)
-            animations.emplace_back(std::make_unique<CellLockAnim>(coord.first, coord.second));
+        for (unsigned i = 0; i < pending_anim_count; i++)
+            animations.addCellLock(pending_anims[i].first, pending_anims[i].second);
     }
 }
 
@@ -413,19 +476,22 @@ void Well::checkLineclear()
         }
 
         if (row_filled)
-            pending_cleared_rows.insert(row);
+            pending_cleared_rows.set(row);
     }
 
-    assert(pending_cleared_rows.size() <= 4); // you can clear only 4 rows at once
-    if (pending_cleared_rows.size()) {
-        for (auto row : pending_cleared_rows) {
+    assert(pending_cleared_rows.count() <= 4); // you can clear only 4 rows at once
+    if (pending_cleared_rows.any()) {
+        for (unsigned row = 0; row < matrix.size(); row++) {
+            if (!pending_cleared_rows.test(row))
+                continue;
+
             for (auto& cell : matrix[row])
                 cell = nullptr;
 
             if (row >= 2)
-                animations.emplace_back(std::make_unique<LineClearAnim>(row));
+                animations.addLineClear(row);
             else if (row == 1)
-                animations.emplace_back(std::make_unique<HalfHeightLineClearAnim>());
+                animations.addHalfHeightLineClear();
 
             temporal_disable_timer = Timing::frame_duration_60Hz * 40; // TODO: make this configurable
         }
@@ -437,33 +503,53 @@ void Well::checkLineclear()
 void Well::removeEmptyRows()
 {
     // this function should be called if there are empty rows
-    assert(pending_cleared_rows.size());
-    assert(pending_cleared_rows.size() <= 4);
+    assert(pending_cleared_rows.any());
+    assert(pending_cleared_rows.count() <= 4);
 
     WellEvent clear_event(WellEvent::Type::LINE_CLEAR);
-    clear_event.lineclear.count = pending_cleared_rows.size();
+    clear_event.lineclear.count = pending_cleared_rows.count();
     clear_event.lineclear.type = last_lineclear_type;
     notify(clear_event);
 
-    for (int row = matrix.size(); row >= 0; row--) {
-        if (!pending_cleared_rows.count(row))
+    for (int row = matrix.size() - 1; row >= 0; row--) {
+        if (!pending_cleared_rows.test(row))
             continue;
 
         int next_filled_row = row;
-        while (pending_cleared_rows.count(next_filled_row))
+        while (next_filled_row >= 0 && pending_cleared_rows.test(next_filled_row))
             next_filled_row--;
 
         if (next_filled_row < 0)
             break;
 
         matrix[row].swap(matrix[next_filled_row]);
-        pending_cleared_rows.insert(next_filled_row);
+        pending_cleared_rows.set(next_filled_row);
     }
 
-    pending_cleared_rows.clear();
+    pending_cleared_rows.reset();
+    matrix_revision++;
+}
+
+void Well::enqueue(const WellEvent& event)
+{
+    // the queue is sized for the worst case of a single update,
+    // and the events must not be delivered while the Wells are updating
+    const bool pushed = pending_events.push(event);
+    assert(pushed);
+    (void) pushed;
 }
 
-void Well::notify(const WellEvent& event)
+unsigned Well::dispatchEvents()
+{
+    unsigned dispatched = 0;
+    while (!pending_events.empty()) {
+        dispatch(pending_events.pop());
+        dispatched++;
+    }
+    return dispatched;
+}
+
+void Well::dispatch(const WellEvent& event)
 {
     for (const auto& obs : observers[static_cast<uint8_t>(event.type)])
         obs(event);
@@ -487,3 +573,8 @@ void Well::drawContent(GraphicsContext& gcx, int x, int y) const
 {
     renderer.drawContent(*this, gcx, x, y);
 }
+
+void Well::drawMiniContent(GraphicsContext& gcx, int x, int y, int cell_size) const
+{
+    renderer.drawMini(*this, gcx, x, y, cell_size);
+}
@@ -1,18 +1,22 @@
 #pragma once
 
+#include "PieceType.h"
 #include "game/WellEvent.h"
+#include "game/util/Delegate.h"
 #include "game/util/Matrix.h"
+#include "well/Animations.h"
 #include "well/AutoRepeat.h"
+#include "well/EventQueue.h"
 #include "well/Input.h"
 #include "well/Gravity.h"
 #include "well/LockDelay.h"
 #include "well/Render.h"
 #include "well/TSpin.h"
 
-#include <list>
+#include <array>
+#include <bitset>
 #include <memory>
-#include <set>
-#include <unordered_map>
+#include <random>
 #include <vector>
 #include <stdint.h>
 
@@ -27,9 +31,7 @@ class GraphicsContext;
 class Mino;
 class Piece;
 class RotationFn;
-class WellAnimation;
 struct WellConfig;
-enum class PieceType : uint8_t;
 
 
 class Well {
@@ -43,13 +45,16 @@ public:
     /// is not directly accessible, so it is required to check the input
     /// events every frame. This function does not call any game logic.
     void updateKeystateOnly(const std::vector<InputEvent>&);
-    /// Update the active animations of the well
-    void updateAnimationsOnly();
+    /// Advance the active animations of the well
+    void updateAnimationsOnly(Duration);
     /// Update the game logic of the well
     void updateGameplayOnly(const std::vector<InputEvent>&);
 
     /// Add a new, player-controllable piece to the well.
     void addPiece(PieceType);
+    /// Create one piece of every type in advance, so `addPiece` never allocates.
+    /// The initial positions of the PieceFactory must be set already.
+    void createSparePieces();
     /// Delete the currently controlled Piece. A new one will be requested eventually.
     void deletePiece();
     /// Returns the current, active piece, controllable by the player.
@@ -58,8 +63,21 @@ public:
     /// For actual input handling, call Well's update method.
     const std::unique_ptr<Piece>& activePiece() const { return active_piece; }
 
-    /// Add garbage lines to the bottom of the well.
+    /// Add garbage lines to the bottom of the well, with a random gap.
     void addGarbageLines(unsigned short);
+    /// Push up the contents of the well, and insert the rows to the bottom.
+    /// The rows are given from top to bottom as bitmasks (see `rowMask`).
+    void addGarbageRows(const uint16_t* row_masks, unsigned row_count);
+    /// Seed the generator of the garbage gap positions. Every well has its own
+    /// generator, so the result doesn't depend on the order of the well updates.
+    void setGarbageSeed(uint32_t seed) { garbage_rng.seed(seed); }
+
+    /// The size of the well's grid, including the hidden rows
+    static constexpr unsigned matrix_rows = 40;
+    static constexpr unsigned matrix_cols = 10;
+    /// Returns the occupied cells of a grid row as a bitmask,
+    /// with the leftmost column being the lowest bit.
+    uint16_t rowMask(unsigned row) const;
 
     /// Set the gravity update rate
     void setGravity(Duration);
@@ -68,15 +86,29 @@ public:
 
     /// Draw the Minos in the Well
     void drawContent(GraphicsContext&, int x, int y) const;
-
-    /// Register an external event observer.
-    template <typename WellObserver>
-    void registerObserver(WellEvent::Type evtype, WellObserver&& obs) {
-        observers[static_cast<uint8_t>(evtype)].push_back(std::forward<WellObserver>(obs));
+    /// Draw a low-detail version of the visible rows, with `cell_size` pixel cells
+    void drawMiniContent(GraphicsContext&, int x, int y, int cell_size) const;
+
+    /// An external event observer. The callable is stored inline,
+    /// so it must fit into a few pointers (eg. a lambda with some captures).
+    using Observer = Delegate<void(const WellEvent&)>;
+    /// Register an external event observer. The events are not delivered
+    /// immediately, but queued until the next `dispatchEvents` call.
+    void registerObserver(WellEvent::Type evtype, Observer&& obs) {
+        const auto type_idx = static_cast<uint8_t>(evtype);
+        observers[type_idx].push_back(std::move(obs));
+        observed_types |= 1u << type_idx;
     }
 
+    /// Deliver the events queued during the updates to the observers, in order.
+    /// Events created by the observers are also delivered before returning.
+    /// Returns the number of delivered events.
+    unsigned dispatchEvents();
+
 #ifndef NDEBUG
-    void update(const std::vector<InputEvent>&); ///< Update both the keystate and the game logic
+    /// Update both the keystate and the game logic. The events are not
+    /// delivered until `dispatchEvents()` is called.
+    void update(const std::vector<InputEvent>&);
     std::string asAscii() const;
     void fromAscii(const std::string&);
 #endif
@@ -89,13 +121,16 @@ private:
 
     // the grid matrix
     // TODO: set dimensions from config
-    Matrix<std::shared_ptr<Mino>, 40, 10> matrix;
+    Matrix<std::shared_ptr<Mino>, matrix_rows, matrix_cols> matrix;
+    uint32_t matrix_revision; ///< increased when the contents of the matrix change
 
     // the active piece
     int8_t active_piece_x;
     uint8_t active_piece_y;
     uint8_t ghost_piece_y;
     std::unique_ptr<Piece> active_piece;
+    // the pieces are reused after they were locked, to avoid allocations
+    std::array<std::unique_ptr<Piece>, PieceTypeList.size()> spare_pieces;
 
     // softdrop timers
     Duration softdrop_delay;
@@ -106,6 +141,8 @@ private:
     void moveLeftNow();
     void moveRightNow();
     void moveDownNow();
+    /// Move the piece down at most `rows` rows at once; used by the gravity
+    void moveDownBy(unsigned rows);
     void hardDrop();
     void rotateNow(RotationDirection);
     bool placeByWallKick(RotationDirection);
@@ -118,18 +155,31 @@ private:
     void lockAndReleasePiece();
     void lockThenRequestNext();
 
+    // garbage
+    std::minstd_rand garbage_rng;
+
     // line clears
     void checkLineclear();
     void removeEmptyRows();
-    std::set<uint8_t> pending_cleared_rows;
+    std::bitset<matrix_rows> pending_cleared_rows;
     LineClearType last_lineclear_type;
 
     // listeners
-    std::unordered_map<uint8_t, std::vector<std::function<void(const WellEvent&)>>> observers;
-    void notify(const WellEvent&);
+    // the observer lists are indexed by the event type, and event types
+    // without observers are filtered out by the bitmask before queueing
+    std::array<std::vector<Observer>, WellEvent::type_count> observers;
+    uint16_t observed_types;
+    static_assert(WellEvent::type_count <= 16, "The observer bitmask is too small");
+    WellComponents::EventQueue pending_events;
+    void notify(const WellEvent& event) {
+        if (observed_types & (1u << static_cast<uint8_t>(event.type)))
+            enqueue(event);
+    }
+    void enqueue(const WellEvent&);
+    void dispatch(const WellEvent&);
 
     // animations
-    std::list<std::unique_ptr<WellAnimation>> animations;
+    WellComponents::Animations animations;
 
     // components
     WellComponents::AutoRepeat das;
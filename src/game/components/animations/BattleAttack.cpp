@@ -6,15 +6,29 @@
 #include <cmath>
 
 
-BattleAttackAnim::BattleAttackAnim(int start_x, int width, int center_y, int arc_y, std::function<void()>&& callback)
-    : arc_center_x(start_x + width / 2)
-    , arc_center_y(center_y)
-    , arc_percent(std::chrono::seconds(1), [](double t){ return t; }, std::move(callback))
-    , mino(MinoStorage::getMino(PieceType::GARBAGE))
+BattleAttackAnim::BattleAttackAnim()
+    : arc_center_x(0)
+    , arc_center_y(0)
+    , arc_radius(0)
+    , arc_angle_start(0.0)
+    , arc_angle_end(0.0)
+    , arc_angle_diff(0.0)
+    , arc_x(0.0)
+    , arc_y(0.0)
+    , arc_percent(std::chrono::seconds(1), [](double t){ return t; })
+{
+    arc_percent.stop();
+}
+
+void BattleAttackAnim::start(int start_x, int width, int center_y, int arc_y)
 {
     assert(width != 0);
     assert(center_y < arc_y);
 
+    arc_center_x = start_x + width / 2;
+    arc_center_y = center_y;
+    mino = MinoStorage::getMino(PieceType::GARBAGE);
+
     const double dx1 = start_x - arc_center_x;
     const double dx2 = start_x + width - arc_center_x;
     const double dy = arc_y - center_y;
@@ -26,11 +40,12 @@ BattleAttackAnim::BattleAttackAnim(int start_x, int width, int center_y, int arc
 
     arc_x = std::cos(arc_angle_start);
     arc_y = std::sin(arc_angle_start);
+    arc_percent.restart();
 }
 
-void BattleAttackAnim::update()
+void BattleAttackAnim::update(Duration elapsed)
 {
-    arc_percent.update(Timing::frame_duration);
+    arc_percent.update(elapsed);
 
     const double angle = arc_angle_start + arc_angle_diff * arc_percent.value();
 
@@ -40,6 +55,9 @@ void BattleAttackAnim::update()
 
 void BattleAttackAnim::draw() const
 {
+    if (!isActive())
+        return;
+
     static constexpr int offset = -Mino::texture_size_px / 2;
     mino->draw(arc_x + offset, arc_y + offset);
 }
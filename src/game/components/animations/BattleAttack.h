@@ -11,9 +11,12 @@ class Texture;
 
 class BattleAttackAnim {
 public:
-    BattleAttackAnim(int start_x, int width, int center_y, int arc_y, std::function<void()>&& callback = []{});
+    /// Create an inactive animation
+    BattleAttackAnim();
+    /// (Re)start the animation, flying from `start_x` to `start_x + width`
+    void start(int start_x, int width, int center_y, int arc_y);
 
-    void update();
+    void update(Duration);
     void draw() const;
 
     bool isActive() const { return arc_percent.running(); }
@@ -7,15 +7,25 @@
 #include <algorithm>
 
 
-CellLockAnim::CellLockAnim(unsigned row, unsigned col)
+CellLockAnim::CellLockAnim()
     : WellAnimation()
-    , cell_x(col * Mino::texture_size_px)
-    , cell_y_top(row * Mino::texture_size_px)
-    , cell_y_bottom(cell_y_top + Mino::texture_size_px)
+    , cell_x(0)
+    , cell_y_top(0)
+    , cell_y_bottom(0)
     , anim_y_top(Timing::frame_duration_60Hz * 20, [this](double t){
         return this->cell_y_bottom - t * Mino::texture_size_px * 2;
     })
-{}
+{
+    anim_y_top.stop();
+}
+
+void CellLockAnim::start(unsigned row, unsigned col)
+{
+    cell_x = col * Mino::texture_size_px;
+    cell_y_top = row * Mino::texture_size_px;
+    cell_y_bottom = cell_y_top + Mino::texture_size_px;
+    anim_y_top.restart();
+}
 
 void CellLockAnim::update(Duration t) {
     anim_y_top.update(t);
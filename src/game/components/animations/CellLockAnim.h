@@ -8,7 +8,10 @@ class GraphicsContext;
 
 class CellLockAnim : public WellAnimation {
 public:
-    CellLockAnim(unsigned row, unsigned col);
+    /// Create an inactive animation
+    CellLockAnim();
+    /// (Re)start the animation at the provided cell
+    void start(unsigned row, unsigned col);
 
     void update(Duration t) final;
     void draw(GraphicsContext& gcx, int x, int y) const final;
@@ -16,9 +19,9 @@ public:
     bool isActive() const final { return anim_y_top.running(); }
 
 private:
-    const unsigned cell_x;
-    const unsigned cell_y_top;
-    const unsigned cell_y_bottom;
+    unsigned cell_x;
+    unsigned cell_y_top;
+    unsigned cell_y_bottom;
 
     Transition<int> anim_y_top;
 };
@@ -4,9 +4,10 @@
 #include "system/GraphicsContext.h"
 
 
-HalfHeightLineClearAnim::HalfHeightLineClearAnim()
-    : LineClearAnim(19)
-{}
+void HalfHeightLineClearAnim::start()
+{
+    LineClearAnim::start(19);
+}
 
 void HalfHeightLineClearAnim::draw(GraphicsContext& gcx, int x, int y) const
 {
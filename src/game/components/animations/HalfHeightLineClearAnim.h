@@ -5,6 +5,7 @@
 
 class HalfHeightLineClearAnim : public LineClearAnim {
 public:
-    HalfHeightLineClearAnim();
+    /// (Re)start the animation at the top, partially visible row
+    void start();
     void draw(GraphicsContext& gcx, int x, int y) const override;
 };
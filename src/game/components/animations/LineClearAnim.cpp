@@ -8,13 +8,21 @@ constexpr Duration TIME_PER_ROW = Timing::frame_duration_60Hz * 40;
 
 RGBAColor LineClearAnim::anim_color = 0xEEEEEEFF_rgba;
 
-LineClearAnim::LineClearAnim(unsigned row)
+LineClearAnim::LineClearAnim()
     : WellAnimation()
-    , row(row)
-    , row_percent(TIME_PER_ROW, [this](double t){
+    , row(0)
+    , row_percent(TIME_PER_ROW, [](double t){
             return t;
         })
-{}
+{
+    row_percent.stop();
+}
+
+void LineClearAnim::start(unsigned new_row)
+{
+    row = new_row;
+    row_percent.restart();
+}
 
 void LineClearAnim::update(Duration t)
 {
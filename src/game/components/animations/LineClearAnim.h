@@ -7,9 +7,13 @@
 
 class LineClearAnim : public WellAnimation {
 public:
-    LineClearAnim(unsigned row);
+    /// Create an inactive animation
+    LineClearAnim();
     virtual ~LineClearAnim() {}
 
+    /// (Re)start the animation at the provided matrix row
+    void start(unsigned row);
+
     void update(Duration t) override;
     void draw(GraphicsContext& gcx, int x, int y) const override;
 
@@ -18,6 +22,6 @@ public:
     static RGBAColor anim_color;
 
 protected:
-    const int row;
+    int row;
     Transition<double> row_percent;
 };
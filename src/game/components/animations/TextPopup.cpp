@@ -2,15 +2,16 @@
 
 #include "game/AppContext.h"
 #include "system/Font.h"
-#include "system/Texture.h"
 
 
+constexpr size_t TextPopup::max_text_length;
 RGBAColor TextPopup::text_color = 0xEEEEEEFF_rgba;
 
-TextPopup::TextPopup(const std::string& text, std::shared_ptr<Font>& font)
-    : text(text)
+TextPopup::TextPopup()
+    : text_width(0)
     , pos_x(0)
     , pos_y(0)
+    , visible(false)
     , pos_y_delta(std::chrono::seconds(2), [](double t){
             return t * 100;
         })
@@ -18,30 +19,45 @@ TextPopup::TextPopup(const std::string& text, std::shared_ptr<Font>& font)
             return (1.0 - t) * 0xFF;
         })
 {
-    tex = font->renderText(text, text_color);
-    tex->setAlpha(0x0);
+    text.reserve(max_text_length);
+    pos_y_delta.stop();
+    alpha.stop();
+}
+
+void TextPopup::start(const std::string& new_text, const std::shared_ptr<Font>& new_font)
+{
+    text = new_text;
+    font = new_font;
+    text_width = font->textWidth(text);
+    visible = false;
+    pos_y_delta.restart();
+    alpha.restart();
 }
 
 void TextPopup::setInitialPosition(int x, int y)
 {
     pos_x = x;
     pos_y = y;
-    tex->setAlpha(0xFF);
+    visible = true;
 }
 
 unsigned TextPopup::width() const
 {
-    return tex->width();
+    return text_width;
 }
 
-void TextPopup::update()
+void TextPopup::update(Duration elapsed)
 {
-    pos_y_delta.update(Timing::frame_duration);
-    alpha.update(Timing::frame_duration);
-    tex->setAlpha(alpha.value());
+    pos_y_delta.update(elapsed);
+    alpha.update(elapsed);
 }
 
 void TextPopup::draw() const
 {
-    tex->drawAt(pos_x, pos_y - pos_y_delta.value());
+    if (!visible)
+        return;
+
+    RGBAColor color = text_color;
+    color.a = alpha.value();
+    font->drawText(text, pos_x, pos_y - pos_y_delta.value(), color);
 }
@@ -5,16 +5,22 @@
 
 #include <memory>
 #include <string>
+#include <stddef.h>
 
 class Font;
-class Texture;
 
 
 class TextPopup {
 public:
-    TextPopup(const std::string& text, std::shared_ptr<Font>& font);
+    /// The longest text that can be shown without allocation
+    static constexpr size_t max_text_length = 64;
 
-    void update();
+    /// Create an inactive popup
+    TextPopup();
+    /// (Re)start the popup with the provided text. Its position is set later.
+    void start(const std::string& text, const std::shared_ptr<Font>& font);
+
+    void update(Duration);
     void draw() const;
 
     unsigned width() const;
@@ -26,10 +32,11 @@ public:
     static RGBAColor text_color;
 
 private:
-    const std::string text;
+    std::string text;
+    std::shared_ptr<Font> font;
+    unsigned text_width;
     int pos_x, pos_y;
+    bool visible;
     Transition<int> pos_y_delta;
     Transition<uint8_t> alpha;
-
-    std::unique_ptr<Texture> tex;
 };
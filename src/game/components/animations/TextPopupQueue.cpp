@@ -0,0 +1,44 @@
+#include "TextPopupQueue.h"
+
+
+constexpr size_t TextPopupQueue::capacity;
+
+TextPopupQueue::TextPopupQueue()
+    : head(0)
+    , count(0)
+{}
+
+void TextPopupQueue::push(const std::string& text, const std::shared_ptr<Font>& font)
+{
+    if (count == capacity) {
+        head = (head + 1) % capacity;
+        count--;
+    }
+
+    popups[(head + count) % capacity].start(text, font);
+    count++;
+}
+
+void TextPopupQueue::update(Duration elapsed, int center_x, int y)
+{
+    // remove old animations
+    while (count > 0 && !popups[head].isActive()) {
+        head = (head + 1) % capacity;
+        count--;
+    }
+
+    // newly created popups don't know their position
+    for (size_t i = 0; i < count; i++) {
+        auto& popup = popups[(head + i) % capacity];
+        popup.setInitialPosition(center_x - static_cast<int>(popup.width()) / 2, y);
+        popup.update(elapsed);
+        if (popup.visibility() > (0.6 * 0xFF))
+            break;
+    }
+}
+
+void TextPopupQueue::draw() const
+{
+    for (size_t i = 0; i < count; i++)
+        popups[(head + i) % capacity].draw();
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "TextPopup.h"
+
+#include <array>
+#include <memory>
+#include <string>
+#include <stddef.h>
+
+class Font;
+
+
+/// The text popups of a player, shown one after the other. The popups are
+/// stored in a fixed size ring, and are restarted instead of created,
+/// so they never allocate. If the ring is full, the oldest popup is dropped.
+class TextPopupQueue {
+public:
+    static constexpr size_t capacity = 8;
+
+    TextPopupQueue();
+
+    void push(const std::string& text, const std::shared_ptr<Font>& font);
+
+    /// Update the animations. The popups start horizontally centered at `center_x`.
+    void update(Duration, int center_x, int y);
+    void draw() const;
+
+private:
+    std::array<TextPopup, capacity> popups;
+    size_t head;
+    size_t count;
+};
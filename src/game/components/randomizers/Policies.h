@@ -0,0 +1,135 @@
+#pragma once
+
+#include "game/components/PieceType.h"
+
+#include <algorithm>
+#include <array>
+#include <stdint.h>
+
+
+/// Piece randomizer policies. Every policy produces a block of
+/// `block_size` pieces per call, using a SplitMix64 random generator.
+/// The policies are used as template parameters (see Randomizer.h),
+/// so their generation loops are compiled separately for each of them.
+namespace Randomizers {
+
+/// SplitMix64, a small and fast generator with a 64-bit state
+class SplitMix64 {
+public:
+    explicit SplitMix64(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    /// A random number in [0, n), using a multiplication instead of division
+    unsigned below(unsigned n) {
+        return static_cast<unsigned>(((next() >> 32) * n) >> 32);
+    }
+
+private:
+    uint64_t state;
+};
+
+template <size_t N>
+void shuffle(std::array<PieceType, N>& pieces, size_t count, SplitMix64& rng)
+{
+    for (size_t i = count - 1; i > 0; i--)
+        std::swap(pieces[i], pieces[rng.below(i + 1)]);
+}
+
+
+/// Every piece once, in random order
+struct Bag7 {
+    static constexpr unsigned block_size = 7;
+
+    void generate(SplitMix64& rng, std::array<PieceType, block_size>& out) {
+        out = PieceTypeList;
+        shuffle(out, out.size(), rng);
+    }
+};
+
+/// Every piece twice, in random order
+struct Bag14 {
+    static constexpr unsigned block_size = 14;
+
+    void generate(SplitMix64& rng, std::array<PieceType, block_size>& out) {
+        std::copy(PieceTypeList.begin(), PieceTypeList.end(), out.begin());
+        std::copy(PieceTypeList.begin(), PieceTypeList.end(), out.begin() + PieceTypeList.size());
+        shuffle(out, out.size(), rng);
+    }
+};
+
+/// Every piece is independent from the previous ones
+struct PureRandom {
+    static constexpr unsigned block_size = 7;
+
+    void generate(SplitMix64& rng, std::array<PieceType, block_size>& out) {
+        for (auto& piece : out)
+            piece = PieceTypeList[rng.below(PieceTypeList.size())];
+    }
+};
+
+/// The randomizer of TGM2: a piece is rerolled a few times if it's in the
+/// history of the last 4 pieces, and the first piece is never S, Z or O
+struct TGMHistory {
+    static constexpr unsigned block_size = 7;
+    static constexpr unsigned max_rolls = 6;
+
+    std::array<PieceType, 4> history;
+    std::array<uint8_t, PieceTypeList.size()> history_count; ///< for fast lookup
+    unsigned history_pos;
+    bool first;
+
+    TGMHistory()
+        : history({{PieceType::Z, PieceType::S, PieceType::S, PieceType::Z}})
+        , history_count()
+        , history_pos(0)
+        , first(true)
+    {
+        for (const PieceType piece : history)
+            history_count[static_cast<size_t>(piece)]++;
+    }
+
+    void generate(SplitMix64& rng, std::array<PieceType, block_size>& out) {
+        for (auto& out_piece : out) {
+            PieceType piece;
+            if (first) {
+                static constexpr std::array<PieceType, 4> first_pieces = {{
+                    PieceType::I, PieceType::J, PieceType::L, PieceType::T,
+                }};
+                piece = first_pieces[rng.below(first_pieces.size())];
+                first = false;
+            }
+            else {
+                for (unsigned roll = 0; roll < max_rolls; roll++) {
+                    piece = PieceTypeList[rng.below(PieceTypeList.size())];
+                    if (!history_count[static_cast<size_t>(piece)])
+                        break;
+                }
+            }
+
+            history_count[static_cast<size_t>(history[history_pos])]--;
+            history_count[static_cast<size_t>(piece)]++;
+            history[history_pos] = piece;
+            history_pos = (history_pos + 1) % history.size();
+            out_piece = piece;
+        }
+    }
+};
+
+/// Every piece once plus a random one, in random order
+struct Bag7Plus1 {
+    static constexpr unsigned block_size = 8;
+
+    void generate(SplitMix64& rng, std::array<PieceType, block_size>& out) {
+        std::copy(PieceTypeList.begin(), PieceTypeList.end(), out.begin());
+        out.back() = PieceTypeList[rng.below(PieceTypeList.size())];
+        shuffle(out, out.size(), rng);
+    }
+};
+
+} // namespace Randomizers
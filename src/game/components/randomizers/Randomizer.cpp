@@ -0,0 +1,22 @@
+#include "Randomizer.h"
+
+#include "system/util/MakeUnique.h"
+
+#include <assert.h>
+
+
+std::unique_ptr<Randomizer> RandomizerFactory::make(RandomizerType type, uint64_t seed)
+{
+    using namespace Randomizers;
+
+    switch (type) {
+        case RandomizerType::BAG7: return std::make_unique<RandomizerImpl<Bag7>>(seed);
+        case RandomizerType::BAG14: return std::make_unique<RandomizerImpl<Bag14>>(seed);
+        case RandomizerType::PURE_RANDOM: return std::make_unique<RandomizerImpl<PureRandom>>(seed);
+        case RandomizerType::TGM_HISTORY: return std::make_unique<RandomizerImpl<TGMHistory>>(seed);
+        case RandomizerType::BAG7_PLUS1: return std::make_unique<RandomizerImpl<Bag7Plus1>>(seed);
+    }
+
+    assert(false);
+    exit(1);
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Policies.h"
+#include "RandomizerType.h"
+
+#include <array>
+#include <memory>
+#include <stdint.h>
+
+
+namespace Randomizers {
+
+/// The largest block size of the policies
+static constexpr unsigned max_block_size = 14;
+
+/// A randomizer policy with its own generator state, without virtual calls.
+/// Two generators of the same policy and seed produce the same pieces.
+template <typename Policy>
+class Generator {
+public:
+    static_assert(Policy::block_size <= max_block_size, "The block size is too large");
+
+    explicit Generator(uint64_t seed)
+        : rng(seed)
+        , pos(Policy::block_size)
+    {}
+
+    PieceType next() {
+        if (pos == Policy::block_size) {
+            policy.generate(rng, block);
+            pos = 0;
+        }
+        return block[pos++];
+    }
+
+    /// Generate the next block of pieces. Returns the number of pieces.
+    unsigned nextBlock(PieceType* out) {
+        policy.generate(rng, block);
+        std::copy(block.begin(), block.end(), out);
+        return Policy::block_size;
+    }
+
+private:
+    SplitMix64 rng;
+    Policy policy;
+    std::array<PieceType, Policy::block_size> block;
+    unsigned pos;
+};
+
+} // namespace Randomizers
+
+
+/// Runtime selectable randomizer. Pieces are produced in blocks,
+/// so there is only one virtual call per block.
+class Randomizer {
+public:
+    virtual ~Randomizer() {}
+
+    /// Write the next block of pieces into `out`, which must have room for
+    /// `Randomizers::max_block_size` pieces. Returns the number of pieces.
+    virtual unsigned nextBlock(PieceType* out) = 0;
+};
+
+template <typename Policy>
+class RandomizerImpl : public Randomizer {
+public:
+    explicit RandomizerImpl(uint64_t seed) : generator(seed) {}
+
+    unsigned nextBlock(PieceType* out) final { return generator.nextBlock(out); }
+
+private:
+    Randomizers::Generator<Policy> generator;
+};
+
+
+class RandomizerFactory {
+public:
+    static std::unique_ptr<Randomizer> make(RandomizerType, uint64_t seed);
+};
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <stdint.h>
+
+
+enum class RandomizerType : uint8_t {
+    BAG7,
+    BAG14,
+    PURE_RANDOM,
+    TGM_HISTORY,
+    BAG7_PLUS1,
+};
@@ -0,0 +1,59 @@
+#include "Animations.h"
+
+
+namespace WellComponents {
+
+constexpr size_t Animations::cell_lock_capacity;
+constexpr size_t Animations::line_clear_capacity;
+
+Animations::Animations()
+    : next_cell_lock(0)
+    , next_line_clear(0)
+{}
+
+void Animations::addCellLock(unsigned row, unsigned col)
+{
+    cell_locks[next_cell_lock].start(row, col);
+    next_cell_lock = (next_cell_lock + 1) % cell_lock_capacity;
+}
+
+void Animations::addLineClear(unsigned row)
+{
+    line_clears[next_line_clear].start(row);
+    next_line_clear = (next_line_clear + 1) % line_clear_capacity;
+}
+
+void Animations::addHalfHeightLineClear()
+{
+    half_height_line_clear.start();
+}
+
+void Animations::update(Duration t)
+{
+    for (auto& anim : cell_locks) {
+        if (anim.isActive())
+            anim.update(t);
+    }
+    for (auto& anim : line_clears) {
+        if (anim.isActive())
+            anim.update(t);
+    }
+    if (half_height_line_clear.isActive())
+        half_height_line_clear.update(t);
+}
+
+void Animations::draw(GraphicsContext& gcx, int x, int y) const
+{
+    for (const auto& anim : cell_locks) {
+        if (anim.isActive())
+            anim.draw(gcx, x, y);
+    }
+    for (const auto& anim : line_clears) {
+        if (anim.isActive())
+            anim.draw(gcx, x, y);
+    }
+    if (half_height_line_clear.isActive())
+        half_height_line_clear.draw(gcx, x, y);
+}
+
+} // namespace WellComponents
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "game/Timing.h"
+#include "game/components/animations/CellLockAnim.h"
+#include "game/components/animations/HalfHeightLineClearAnim.h"
+#include "game/components/animations/LineClearAnim.h"
+
+#include <array>
+#include <stddef.h>
+
+
+class GraphicsContext;
+
+
+namespace WellComponents {
+
+/// The visual effects of the Well. The animations are stored in fixed size
+/// pools, and are restarted instead of created, so they never allocate.
+/// If a pool is full, its oldest animation is reused.
+class Animations {
+public:
+    static constexpr size_t cell_lock_capacity = 64;
+    static constexpr size_t line_clear_capacity = 4;
+
+    Animations();
+
+    void addCellLock(unsigned row, unsigned col);
+    void addLineClear(unsigned row);
+    void addHalfHeightLineClear();
+
+    void update(Duration);
+    void draw(GraphicsContext&, int x, int y) const;
+
+private:
+    std::array<CellLockAnim, cell_lock_capacity> cell_locks;
+    size_t next_cell_lock;
+    std::array<LineClearAnim, line_clear_capacity> line_clears;
+    size_t next_line_clear;
+    HalfHeightLineClearAnim half_height_line_clear;
+};
+
+} // namespace WellComponents
@@ -26,6 +26,7 @@ void Ascii::fromAscii(Well& well, const std::string& text)
         // newline skip
         str_i++;
     }
+    well.matrix_revision++;
 }
 
 std::string Ascii::asAscii(const Well& well) const
@@ -0,0 +1,38 @@
+#include "EventQueue.h"
+
+#include <assert.h>
+
+
+namespace WellComponents {
+
+constexpr unsigned EventQueue::max_presses_per_update;
+constexpr unsigned EventQueue::capacity;
+
+EventQueue::EventQueue()
+    : ring(capacity, WellEvent(WellEvent::Type::PIECE_LOCKED))
+    , head(0)
+    , count(0)
+{
+}
+
+bool EventQueue::push(const WellEvent& event)
+{
+    if (full())
+        return false;
+
+    ring[(head + count) % capacity] = event;
+    count++;
+    return true;
+}
+
+WellEvent EventQueue::pop()
+{
+    assert(!empty());
+
+    const unsigned idx = head;
+    head = (head + 1) % capacity;
+    count--;
+    return ring[idx];
+}
+
+} // namespace WellComponents
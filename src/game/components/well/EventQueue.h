@@ -0,0 +1,41 @@
+#pragma once
+
+#include "game/WellEvent.h"
+
+#include <vector>
+
+
+namespace WellComponents {
+
+/// A fixed-capacity ring buffer of the Well's events. The events are
+/// collected during the Well's update, and delivered to the observers
+/// after every Well has finished its frame.
+class EventQueue {
+public:
+    /// The Input component handles at most this many key presses per update;
+    /// a human can't press more keys than this in a single frame.
+    static constexpr unsigned max_presses_per_update = 16;
+    /// The most events a Well can produce in a single update: every key press
+    /// produces at most two (eg. a rotation and a T-spin, or a hard drop and its lock),
+    /// while movement, soft drop, locking, line clears and game over
+    /// can only happen once per update. Garbage doesn't produce events.
+    static constexpr unsigned capacity = 2 * max_presses_per_update + 8;
+
+    EventQueue();
+
+    /// Append an event. Returns false if the queue is full.
+    bool push(const WellEvent&);
+    /// Remove and return the oldest event. The queue must not be empty.
+    WellEvent pop();
+
+    bool empty() const { return count == 0; }
+    bool full() const { return count == capacity; }
+    unsigned size() const { return count; }
+
+private:
+    std::vector<WellEvent> ring; ///< always `capacity` long
+    unsigned head;
+    unsigned count;
+};
+
+} // namespace WellComponents
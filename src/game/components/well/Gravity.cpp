@@ -28,20 +28,23 @@ void Gravity::skipNextUpdate()
 void Gravity::update(Well& well)
 {
     gravity_timer += Timing::frame_duration;
-    while (gravity_timer >= gravity_delay) {
-        gravity_timer -= gravity_delay;
+    if (gravity_timer >= gravity_delay) {
+        // at high speeds the piece can fall multiple rows in one frame,
+        // which is handled in a single step
+        const auto rows = gravity_timer / gravity_delay;
+        gravity_timer -= rows * gravity_delay;
 
         // do not apply downward movement twice
         if (!skip_gravity)
-            applyGravity(well);
+            applyGravity(well, static_cast<unsigned>(rows));
     }
 
     skip_gravity = false;
 }
 
-void Gravity::applyGravity(Well& well)
+void Gravity::applyGravity(Well& well, unsigned rows)
 {
-    well.moveDownNow();
+    well.moveDownBy(rows);
 }
 
 } // namespace WellComponents
@@ -25,8 +25,8 @@ private:
     Duration gravity_timer;
     bool skip_gravity;
 
-    /// Asks the well to move the active piece one row down
-    void applyGravity(Well&);
+    /// Asks the well to move the active piece down by the given number of rows
+    void applyGravity(Well&, unsigned rows);
 };
 
 } // namespace WellComponents
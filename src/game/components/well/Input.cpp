@@ -1,11 +1,13 @@
 #include "Input.h"
 
+#include "EventQueue.h"
 #include "game/components/Well.h"
 
 
 namespace WellComponents {
 
 Input::Input()
+    : harddrop_pending(false)
 {
     keystates[InputType::GAME_MOVE_LEFT] = false;
     keystates[InputType::GAME_MOVE_RIGHT] = false;
@@ -25,12 +27,27 @@ void Input::updateKeystate(const std::vector<InputEvent>& events)
 
 void Input::handleKeys(Well& well, const std::vector<InputEvent>& events)
 {
+    if (harddrop_pending && well.active_piece) {
+        harddrop_pending = false;
+        well.hardDrop();
+        well.gravity.skipNextUpdate();
+    }
+
     // for some events onpress/onrelease handling is better suited
+    unsigned presses = 0;
     for (const auto& event : events) {
         // press
         if (event.down()) {
+            // keeps the events of one update within the queue's capacity
+            if (++presses > EventQueue::max_presses_per_update)
+                continue;
+
             switch (event.type()) {
             case InputType::GAME_HARDDROP:
+                if (!well.active_piece) {
+                    harddrop_pending = true;
+                    break;
+                }
                 well.hardDrop();
                 well.gravity.skipNextUpdate();
                 break;
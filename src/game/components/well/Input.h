@@ -23,6 +23,9 @@ public:
 private:
     std::unordered_map<InputType, bool, InputTypeHash> keystates;
     decltype(keystates) previous_keystates;
+    /// A hard drop was pressed while there was no active piece, because the next one
+    /// is only added after the update; it's done when the piece arrives
+    bool harddrop_pending;
 };
 
 } // namespace WellComponents
@@ -1,10 +1,13 @@
 #include "Render.h"
 
+#include "Animations.h"
 #include "game/components/Mino.h"
 #include "game/components/MinoStorage.h"
 #include "game/components/Piece.h"
 #include "game/components/Well.h"
-#include "game/components/animations/WellAnimation.h"
+#include "system/Color.h"
+#include "system/GraphicsContext.h"
+#include "system/Texture.h"
 
 #include <stddef.h>
 
@@ -14,11 +17,15 @@ namespace WellComponents {
 Render::Render()
     : top_row_height(Mino::texture_size_px * 0.3)
     , top_row_cliprect({0, Mino::texture_size_px - top_row_height, Mino::texture_size_px, top_row_height})
+    , layer_revision(0)
+    , layer_generation(0)
+    , layer_dirty(true)
 {}
 
-void Render::drawContent(const Well& well, GraphicsContext& gcx, int draw_offset_x, int draw_offset_y) const
+Render::~Render() = default;
+
+void Render::drawMatrix(const Well& well, int draw_offset_x, int draw_offset_y) const
 {
-    // Draw board Minos
     for (int col = 0; col < 10; col++) {
         const auto& cell = well.matrix.at(19).at(col);
         if (cell) {
@@ -37,16 +44,37 @@ void Render::drawContent(const Well& well, GraphicsContext& gcx, int draw_offset
             }
         }
     }
+}
+
+void Render::drawContent(const Well& well, GraphicsContext& gcx, int draw_offset_x, int draw_offset_y) const
+{
+    // Draw board Minos, from the cached layer
+    if (!layer) {
+        layer = gcx.createRenderTarget(10 * Mino::texture_size_px, 20 * Mino::texture_size_px + top_row_height);
+        layer_dirty = true;
+    }
+    if (layer_dirty
+        || layer_revision != well.matrix_revision
+        || layer_generation != gcx.renderTargetGeneration()) {
+        gcx.drawIntoTexture(*layer, [this, &well](){ drawMatrix(well, 0, 0); });
+        layer_revision = well.matrix_revision;
+        layer_generation = gcx.renderTargetGeneration();
+        layer_dirty = false;
+    }
+    layer->drawAt(draw_offset_x, draw_offset_y);
+    draw_offset_y += top_row_height;
 
     // Draw current piece
     if (well.active_piece) {
+        const auto& grid = well.active_piece->currentGrid();
+
         // draw ghost
         const auto& ghost_cell = MinoStorage::getGhost(well.active_piece->type());
-        for (unsigned row = 0; row < 4; row++) {
+        for (int row = 0; row < 4; row++) {
             if (well.ghost_piece_y + row < 20) // hide buffer zone
                 continue;
-            for (unsigned col = 0; col < 4; col++) {
-                if (well.active_piece->currentGrid().at(row).at(col)) {
+            for (int col = 0; col < 4; col++) {
+                if (grid.at(row).at(col)) {
                     ghost_cell->draw(draw_offset_x + (well.active_piece_x + col) * Mino::texture_size_px,
                                      draw_offset_y + (well.ghost_piece_y + row - 20) * Mino::texture_size_px);
                 }
@@ -61,7 +89,7 @@ void Render::drawContent(const Well& well, GraphicsContext& gcx, int draw_offset
             if (well.active_piece_y + row < 20) { // partially draw the topmost row
                 draw_offset_y -= top_row_height;
                 for (int col = 0; col < 4; col++) {
-                    const auto& cell = well.active_piece->currentGrid().at(row).at(col);
+                    const auto& cell = grid.at(row).at(col);
                     if (cell) {
                         cell->drawPartial(top_row_cliprect, {
                             draw_offset_x + (well.active_piece_x + col) * Mino::texture_size_px,
@@ -73,8 +101,8 @@ void Render::drawContent(const Well& well, GraphicsContext& gcx, int draw_offset
                 continue;
             }
 
-            for (unsigned col = 0; col < 4; col++) {
-                const auto& cell = well.active_piece->currentGrid().at(row).at(col);
+            for (int col = 0; col < 4; col++) {
+                const auto& cell = grid.at(row).at(col);
                 if (cell) {
                     cell->draw(draw_offset_x + (well.active_piece_x + col) * Mino::texture_size_px,
                                draw_offset_y + (well.active_piece_y + row - 20) * Mino::texture_size_px);
@@ -84,8 +112,50 @@ void Render::drawContent(const Well& well, GraphicsContext& gcx, int draw_offset
     }
 
     // Draw animations
-    for (auto& anim : well.animations)
-        anim->draw(gcx, draw_offset_x, draw_offset_y);
+    well.animations.draw(gcx, draw_offset_x, draw_offset_y);
+}
+
+void Render::drawMini(const Well& well, GraphicsContext& gcx,
+                      int draw_offset_x, int draw_offset_y, int cell_size) const
+{
+    static const RGBColor stack_color = 0x909090_rgb;
+    static const RGBColor piece_color = 0xF0F0F0_rgb;
+
+    // Draw the board as one rectangle per continuous run of a row
+    for (unsigned row = 0; row < 20; row++) {
+        const auto& cells = well.matrix.at(row + 20);
+        unsigned col = 0;
+        while (col < 10) {
+            if (!cells[col]) {
+                col++;
+                continue;
+            }
+            const unsigned run_start = col;
+            while (col < 10 && cells[col])
+                col++;
+            gcx.drawFilledRect({
+                static_cast<int>(draw_offset_x + run_start * cell_size),
+                static_cast<int>(draw_offset_y + row * cell_size),
+                static_cast<int>((col - run_start) * cell_size), cell_size}, stack_color);
+        }
+    }
+
+    if (!well.active_piece)
+        return;
+
+    const auto& grid = well.active_piece->currentGrid();
+    for (int row = 0; row < 4; row++) {
+        if (well.active_piece_y + row < 20) // hide buffer zone
+            continue;
+        for (int col = 0; col < 4; col++) {
+            if (grid.at(row).at(col)) {
+                gcx.drawFilledRect({
+                    draw_offset_x + (well.active_piece_x + col) * cell_size,
+                    draw_offset_y + (well.active_piece_y + row - 20) * cell_size,
+                    cell_size, cell_size}, piece_color);
+            }
+        }
+    }
 }
 
 } // namespace WellComponents
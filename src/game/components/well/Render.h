@@ -2,8 +2,12 @@
 
 #include "system/Rectangle.h"
 
+#include <memory>
+#include <stdint.h>
+
 
 class GraphicsContext;
+class Texture;
 class Well;
 
 
@@ -12,11 +16,26 @@ namespace WellComponents {
 class Render {
 public:
     Render();
+    ~Render();
+
+    /// The locked contents of the well are drawn into a texture, which is only
+    /// redrawn when the matrix revision of the well changes (eg. on lock,
+    /// line clear or garbage), or when the render targets were reset
     void drawContent(const Well&, GraphicsContext&, int draw_offset_x, int draw_offset_y) const;
+    /// Draw a low-detail version of the visible rows, using filled rectangles
+    /// of `cell_size` pixels instead of the Mino textures
+    void drawMini(const Well&, GraphicsContext&, int draw_offset_x, int draw_offset_y, int cell_size) const;
 
 private:
     const int top_row_height;
     const Rectangle top_row_cliprect;
+
+    mutable std::unique_ptr<Texture> layer;
+    mutable uint32_t layer_revision;
+    mutable unsigned layer_generation; ///< the render target generation of the last redraw
+    mutable bool layer_dirty; ///< true if the layer was never drawn
+
+    void drawMatrix(const Well&, int draw_offset_x, int draw_offset_y) const;
 };
 
 } // namespace WellComponents
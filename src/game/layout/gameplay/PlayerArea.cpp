@@ -8,6 +8,9 @@
 #include "system/Localize.h"
 #include "system/Paths.h"
 
+#include <algorithm>
+#include <assert.h>
+
 
 namespace Layout {
 
@@ -35,12 +38,14 @@ PlayerArea::GameEndVars::GameEndVars(AppContext& app)
 
 PlayerArea::PlayerArea(AppContext& app, bool draw_gauge)
     : ui_well(app)
+    , next_queue(1, app.wellconfig().randomizer)
     , draw_gauge(draw_gauge)
     , garbage_gauge(app, ui_well.height())
     , rect_level{}
     , rect_score{}
     , rect_goal{}
     , rect_time{}
+    , mini_cell_size(0)
     , game_end(app)
     , special_update([]{})
     , special_draw([](GraphicsContext&){})
@@ -52,6 +57,9 @@ PlayerArea::PlayerArea(AppContext& app, bool draw_gauge)
     auto font_label = app.gcx().loadFont(Paths::data() + "fonts/PTN57F.ttf", 28);
     font_content = app.gcx().loadFont(Paths::data() + "fonts/PTN77F.ttf", 30);
     font_content_highlight = app.gcx().loadFont(Paths::data() + "fonts/PTN77F.ttf", 32);
+    // the counters change during the game
+    font_content->preloadAsciiGlyphs();
+    font_content_highlight->preloadAsciiGlyphs();
 
     tex_next = font_label->renderText(tr("NEXT"), labelcolor_normal);
     tex_hold = font_label->renderText(tr("HOLD"), labelcolor_normal);
@@ -78,10 +86,13 @@ void PlayerArea::setMaxWidth(AppContext& app, unsigned max_width)
         width_narrow += garbage_gauge.width();
     }
 
+    const bool was_mini = isMini();
+    mini_cell_size = 0;
+
     const bool currently_is_narrow = bounding_box.w < width_wide;
     const bool should_be_narrow = static_cast<int>(max_width) < width_wide;
 
-    if (currently_is_narrow != should_be_narrow) {
+    if (was_mini || currently_is_narrow != should_be_narrow) {
         if (should_be_narrow) {
             bounding_box.w = width_narrow;
             bounding_box.h = height_narrow;
@@ -117,6 +128,21 @@ void PlayerArea::setMaxWidth(AppContext& app, unsigned max_width)
     setPosition(x(), y());
 }
 
+void PlayerArea::setMiniLayout(int cell_size)
+{
+    assert(cell_size > 0);
+    mini_cell_size = cell_size;
+
+    bounding_box.w = 10 * cell_size + std::max(2, cell_size / 2) + 1;
+    bounding_box.h = 20 * cell_size;
+
+    layout_fn = [this](){ calcMiniLayout(); };
+    draw_fn_active = [this](GraphicsContext& gcx){ drawMiniActive(gcx); };
+    draw_fn_passive = [this](GraphicsContext& gcx){ drawMiniPassive(gcx); };
+
+    setPosition(x(), y());
+}
+
 void PlayerArea::setPosition(int pos_x, int pos_y)
 {
     Box::setPosition(pos_x, pos_y);
@@ -160,8 +186,18 @@ void PlayerArea::calcNarrowLayout()
     calcUITexPos(900.f);
 }
 
+void PlayerArea::calcMiniLayout()
+{
+    ui_well.setPosition(x(), y());
+}
+
 void PlayerArea::calcWellBox()
 {
+    if (isMini()) {
+        wellbox = { x(), y(), 10 * mini_cell_size, 20 * mini_cell_size };
+        return;
+    }
+
     wellbox = {
         ui_well.wellX(), ui_well.wellY(),
         ui_well.wellWidth(), ui_well.wellHeight()
@@ -186,33 +222,52 @@ void PlayerArea::update()
     special_update();
 }
 
+PlayerArea::Counter::Counter()
+    : font(nullptr)
+    , color{0, 0, 0, 0}
+    , width(0)
+{}
+
+void PlayerArea::Counter::set(Font& new_font, const RGBAColor& new_color, std::string new_text)
+{
+    color = new_color;
+    if (font == &new_font && text == new_text)
+        return;
+
+    font = &new_font;
+    text = std::move(new_text);
+    width = font->textWidth(text);
+}
+
+void PlayerArea::Counter::draw(int x, int y) const
+{
+    assert(font);
+    font->drawText(text, x, y, color);
+}
+
 void PlayerArea::setLevelCounter(bool show_label, unsigned num)
 {
-    tex_level_counter_narrow = font_content->renderText((show_label ? tr("LEVEL ") : "")
-        + std::to_string(num), labelcolor_normal);
-    tex_level_counter_wide = font_content->renderText(std::to_string(num), labelcolor_normal);
+    level_counter_narrow.set(*font_content, labelcolor_normal,
+                             (show_label ? tr("LEVEL ") : "") + std::to_string(num));
+    level_counter_wide.set(*font_content, labelcolor_normal, std::to_string(num));
 }
 
 void PlayerArea::setScore(unsigned num)
 {
-    tex_score_counter = font_content->renderText(std::to_string(num), labelcolor_normal);
+    score_counter.set(*font_content, labelcolor_normal, std::to_string(num));
 }
 
 void PlayerArea::setGoalCounter(unsigned num)
 {
     if (num <= 5)
-        tex_goal_counter = font_content_highlight->renderText(std::to_string(num), labelcolor_highlight);
+        goal_counter.set(*font_content_highlight, labelcolor_highlight, std::to_string(num));
     else
-        tex_goal_counter = font_content->renderText(std::to_string(num), labelcolor_normal);
+        goal_counter.set(*font_content, labelcolor_normal, std::to_string(num));
 }
 
 void PlayerArea::setGametime(Duration gametime)
 {
-    const auto newstr = Timing::toString(gametime);
-    if (newstr != gametime_text) {
-        gametime_text = newstr;
-        tex_time_counter = font_content->renderText(gametime_text, labelcolor_normal);
-    }
+    time_counter.set(*font_content, labelcolor_normal, Timing::toString(gametime));
 }
 
 void PlayerArea::setGarbageCount(unsigned lines)
@@ -243,6 +298,9 @@ void PlayerArea::startGameOver()
             wellbox.w, box_h
         }, 0xA0_rgba);
 
+        if (isMini())
+            return;
+
         auto& tex = *game_end.tex_gameover;
         tex.drawAt(wellCenterX() - tex.width() / 2,
                    wellCenterY() - tex.height() / 2);
@@ -257,7 +315,12 @@ void PlayerArea::startGameFinish()
         anim.update(Timing::frame_duration);
         game_end.tex_finish->setAlpha(anim.value() * 0xFF);
     };
-    special_draw = [this](GraphicsContext&){
+    special_draw = [this](GraphicsContext& gcx){
+        if (isMini()) {
+            gcx.drawFilledRect(wellbox, 0xFFFFFF40_rgba);
+            return;
+        }
+
         auto& tex = *game_end.tex_finish;
         tex.drawAt(wellCenterX() - tex.width() / 2,
                    wellCenterY() - tex.height() / 2);
@@ -297,14 +360,14 @@ void PlayerArea::drawWidePassive(GraphicsContext& gcx) const
     hold_queue.draw(gcx, x(), y() + label_height + inner_padding);
     next_queue.draw(gcx, rightside_x - sidebar_width, y() + label_height + inner_padding);
 
-    tex_score_counter->drawAt(rect_score.x + (rect_score.w - tex_score_counter->width()) / 2,
-                              rect_score.y + 5);
-    tex_time_counter->drawAt(rect_time.x + (rect_time.w - tex_time_counter->width()) / 2,
-                             rect_time.y + 5);
-    tex_goal_counter->drawAt(rect_goal.x + (rect_goal.w - tex_goal_counter->width()) / 2,
-                             rect_goal.y + 5);
-    tex_level_counter_wide->drawAt(rect_level.x + (rect_level.w - tex_level_counter_wide->width()) / 2,
-                                   rect_level.y + 5);
+    score_counter.draw(rect_score.x + (rect_score.w - score_counter.width) / 2,
+                       rect_score.y + 5);
+    time_counter.draw(rect_time.x + (rect_time.w - time_counter.width) / 2,
+                      rect_time.y + 5);
+    goal_counter.draw(rect_goal.x + (rect_goal.w - goal_counter.width) / 2,
+                      rect_goal.y + 5);
+    level_counter_wide.draw(rect_level.x + (rect_level.w - level_counter_wide.width) / 2,
+                            rect_level.y + 5);
 }
 
 void PlayerArea::drawWideActive(GraphicsContext& gcx) const
@@ -329,8 +392,8 @@ void PlayerArea::drawNarrowPassive(GraphicsContext& gcx) const
     hold_queue.draw(gcx, x(), y());
     next_queue.draw(gcx, x() + width() - ui_well.wellWidth() / 2, y());
 
-    tex_level_counter_narrow->drawAt(rect_level.x + 10, rect_level.y);
-    tex_score_counter->drawAt(rect_score.x + rect_score.w - tex_score_counter->width() - 10, rect_score.y);
+    level_counter_narrow.draw(rect_level.x + 10, rect_level.y);
+    score_counter.draw(rect_score.x + rect_score.w - score_counter.width - 10, rect_score.y);
 }
 
 void PlayerArea::drawNarrowActive(GraphicsContext& gcx) const
@@ -340,4 +403,20 @@ void PlayerArea::drawNarrowActive(GraphicsContext& gcx) const
         garbage_gauge.drawActive(gcx);
 }
 
+void PlayerArea::drawMiniPassive(GraphicsContext& gcx) const
+{
+    gcx.drawFilledRect(bounding_box, 0x000000C0_rgba);
+
+    const int bar_width = width() - wellbox.w - 1;
+    const int bar_height = std::min<int>(queuedGarbageLines(), 20) * mini_cell_size;
+    gcx.drawFilledRect({
+        wellbox.x + wellbox.w + 1, y() + height() - bar_height,
+        bar_width, bar_height}, 0xE02020_rgb);
+}
+
+void PlayerArea::drawMiniActive(GraphicsContext& gcx) const
+{
+    ui_well.well().drawMiniContent(gcx, wellbox.x, wellbox.y, mini_cell_size);
+}
+
 } // namespace Layout
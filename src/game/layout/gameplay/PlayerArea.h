@@ -10,6 +10,10 @@
 #include "system/Color.h"
 #include "system/SoundEffect.h"
 
+#include <functional>
+#include <string>
+
+
 class AppContext;
 class Font;
 class GraphicsContext;
@@ -25,6 +29,10 @@ public:
     void update();
     void setPosition(int x, int y) override;
     void setMaxWidth(AppContext&, unsigned);
+    /// Switch to a low-detail layout, which shows only the board and the garbage bar,
+    /// with `cell_size` pixel cells. Used when there are too many wells for the normal layouts.
+    void setMiniLayout(int cell_size);
+    bool isMini() const { return mini_cell_size > 0; }
     void drawActive(GraphicsContext&) const;
     void drawPassive(GraphicsContext&) const;
 
@@ -65,6 +73,18 @@ protected:
     std::shared_ptr<Font> font_content;
     std::shared_ptr<Font> font_content_highlight;
 
+    /// A frequently changing value, drawn from the glyph atlas of its font
+    struct Counter {
+        Font* font;
+        RGBAColor color;
+        std::string text;
+        int width;
+
+        Counter();
+        void set(Font&, const RGBAColor&, std::string);
+        void draw(int x, int y) const;
+    };
+
     ::Rectangle rect_overlay;
     std::unique_ptr<Texture> tex_overlay;
 
@@ -79,20 +99,21 @@ protected:
 
     ::Rectangle rect_level;
     std::unique_ptr<Texture> tex_level;
-    std::unique_ptr<Texture> tex_level_counter_wide;
-    std::unique_ptr<Texture> tex_level_counter_narrow;
+    Counter level_counter_wide;
+    Counter level_counter_narrow;
 
     ::Rectangle rect_score;
     std::unique_ptr<Texture> tex_score;
-    std::unique_ptr<Texture> tex_score_counter;
+    Counter score_counter;
 
     ::Rectangle rect_goal;
     std::unique_ptr<Texture> tex_goal;
-    std::unique_ptr<Texture> tex_goal_counter;
+    Counter goal_counter;
 
-    std::string gametime_text;
     ::Rectangle rect_time;
-    std::unique_ptr<Texture> tex_time_counter;
+    Counter time_counter;
+
+    int mini_cell_size; ///< 0 if the mini layout is not used
 
     void calcWellBox();
     void calcUITexPos(float);
@@ -100,6 +121,7 @@ protected:
     std::function<void()> layout_fn;
     void calcWideLayout();
     void calcNarrowLayout();
+    void calcMiniLayout();
 
     std::function<void(GraphicsContext&)> draw_fn_active;
     std::function<void(GraphicsContext&)> draw_fn_passive;
@@ -107,6 +129,8 @@ protected:
     void drawWidePassive(GraphicsContext&) const;
     void drawNarrowActive(GraphicsContext&) const;
     void drawNarrowPassive(GraphicsContext&) const;
+    void drawMiniActive(GraphicsContext&) const;
+    void drawMiniPassive(GraphicsContext&) const;
 
     struct GameEndVars {
         bool gameoversfx_enabled;
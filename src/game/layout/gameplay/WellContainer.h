@@ -17,6 +17,7 @@ public:
     void drawContent(GraphicsContext&) const;
 
     Well& well() { return m_well; }
+    const Well& well() const { return m_well; }
 
     int wellWidth() const { return 10 * Mino::texture_size_px; }
     int wellHeight() const { return 20.3 * Mino::texture_size_px; }
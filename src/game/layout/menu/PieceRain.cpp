@@ -33,7 +33,7 @@ void PieceRain::setHeight(unsigned height_px)
     displayed_piece_count = 2 + std::ceil(height_px * 1.0 / PIECE_SIDES_PX);
 }
 
-void PieceRain::update()
+void PieceRain::update(Duration elapsed)
 {
     // fill from back if there are too few
     while (active_pieces.size() < displayed_piece_count) {
@@ -47,7 +47,7 @@ void PieceRain::update()
     while (active_pieces.size() > displayed_piece_count)
         active_pieces.pop_front();
 
-    bottom_y.update(Timing::frame_duration);
+    bottom_y.update(elapsed);
 }
 
 void PieceRain::reload()
@@ -17,7 +17,7 @@ public:
 
     void setHeight(unsigned);
 
-    void update();
+    void update(Duration);
     void draw() const;
 
     void reload();
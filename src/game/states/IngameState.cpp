@@ -6,12 +6,17 @@
 #include "substates/ingame/Countdown.h"
 #include "substates/ingame/FadeInOut.h"
 #include "substates/ingame/Gameplay.h"
+#include "substates/ingame/Lobby.h"
 #include "substates/ingame/PlayerSelect.h"
 #include "substates/ingame/TeamSelect.h"
 #include "system/Paths.h"
 #include "system/Texture.h"
 #include "system/util/MakeUnique.h"
 
+#include <algorithm>
+#include <set>
+#include <assert.h>
+
 
 bool isSinglePlayer(GameMode gamemode)
 {
@@ -24,6 +29,11 @@ bool isSinglePlayer(GameMode gamemode)
     return sp_modes.count(gamemode);
 }
 
+bool isBattle(GameMode gamemode)
+{
+    return gamemode == GameMode::MP_BATTLE || gamemode == GameMode::MP_BATTLE_ROYALE;
+}
+
 namespace {
 bool is_team_based(GameMode gamemode)
 {
@@ -32,12 +42,16 @@ bool is_team_based(GameMode gamemode)
 } // namespace
 
 
+constexpr size_t IngameState::max_player_count;
+
 IngameState::IngameState(AppContext& app, GameMode gamemode)
     : gamemode(gamemode)
     , draw_scale(isSinglePlayer(gamemode) ? 1.0 : 0.8)
     , draw_inverse_scale(1.0 / draw_scale)
     , tex_bg_pattern(app.gcx().loadTexture(app.theme().get_texture("game_fill.png")))
 {
+    device_slots.fill(-1);
+
     const auto wallpaper_path = app.theme().random_game_background();
     if (!wallpaper_path.empty())
         tex_bg_wallpaper = app.gcx().loadTexture(wallpaper_path);
@@ -53,7 +67,9 @@ IngameState::IngameState(AppContext& app, GameMode gamemode)
         }));
     }
     else {
-        if (is_team_based(gamemode))
+        if (gamemode == GameMode::MP_BATTLE_ROYALE)
+            states.emplace_back(std::make_unique<SubStates::Ingame::States::Lobby>(app));
+        else if (is_team_based(gamemode))
             states.emplace_back(std::make_unique<SubStates::Ingame::States::TeamSelect>(app));
         else
             states.emplace_back(std::make_unique<SubStates::Ingame::States::PlayerSelect>(app));
@@ -66,25 +82,53 @@ IngameState::IngameState(AppContext& app, GameMode gamemode)
 
 IngameState::~IngameState() = default;
 
+void IngameState::createPlayers(AppContext& app, bool draw_gauge)
+{
+    assert(!device_order.empty());
+    assert(device_order.size() <= max_player_count);
+
+    player_areas.clear();
+    player_stats.clear();
+    for (size_t slot = 0; slot < device_order.size(); slot++) {
+        player_areas.emplace_back(std::make_unique<Layout::PlayerArea>(app, draw_gauge));
+        player_stats.emplace_back();
+    }
+
+    if (isSinglePlayer(gamemode))
+        device_slots.fill(0);
+    else {
+        device_slots.fill(-1);
+        for (size_t slot = 0; slot < device_order.size(); slot++)
+            device_slots[static_cast<uint8_t>(device_order[slot])] = slot;
+    }
+
+    input_events.resize(device_order.size());
+}
+
 void IngameState::updatePositions(AppContext& app)
 {
     if (player_areas.empty())
         return;
 
+    if (player_areas.size() > 4) {
+        tilePlayerAreas(app);
+        return;
+    }
+
     // changing the available width may change the area's width/height
-    const int available_width = draw_inverse_scale * app.gcx().screenWidth() / device_order.size();
-    for (const DeviceID device_id : device_order)
-        player_areas.at(device_id).setMaxWidth(app, available_width);
+    const int available_width = draw_inverse_scale * app.gcx().screenWidth() / player_areas.size();
+    for (auto& parea : player_areas)
+        parea->setMaxWidth(app, available_width);
 
     static const int well_padding_x = 5 + Mino::texture_size_px;
     const int center_x = (app.gcx().screenWidth() * draw_inverse_scale) / 2;
     const int center_y = (app.gcx().screenHeight() * draw_inverse_scale) / 2;
-    const int well_y = center_y - player_areas.cbegin()->second.height() / 2;
-    const int well_full_width = 2 * well_padding_x + player_areas.cbegin()->second.width();
+    const int well_y = center_y - player_areas.front()->height() / 2;
+    const int well_full_width = 2 * well_padding_x + player_areas.front()->width();
     int well_x = center_x - (well_full_width * player_areas.size()) / 2;
 
-    for (const DeviceID device_id : device_order) {
-        player_areas.at(device_id).setPosition(well_x + well_padding_x, well_y);
+    for (auto& parea : player_areas) {
+        parea->setPosition(well_x + well_padding_x, well_y);
         well_x += well_full_width;
     }
 
@@ -97,40 +141,92 @@ void IngameState::updatePositions(AppContext& app)
     }
 }
 
+void IngameState::tilePlayerAreas(AppContext& app)
+{
+    static constexpr int tile_padding = 10;
+    const int screen_width = draw_inverse_scale * app.gcx().screenWidth();
+    const int screen_height = draw_inverse_scale * app.gcx().screenHeight();
+    const int count = player_areas.size();
+
+    // find the column count that allows the largest cells,
+    // a mini board is 10 cells (and a half for the garbage bar) wide, and 20 tall
+    int best_cols = 1;
+    int best_cell_size = 0;
+    for (int cols = 1; cols <= count; cols++) {
+        const int rows = (count + cols - 1) / cols;
+        const int cell_w = (screen_width / cols - tile_padding) * 2 / 21;
+        const int cell_h = (screen_height / rows - tile_padding) / 20;
+        const int cell_size = std::min(cell_w, cell_h);
+        if (cell_size > best_cell_size) {
+            best_cell_size = cell_size;
+            best_cols = cols;
+        }
+    }
+    best_cell_size = std::max(best_cell_size, 1);
+
+    for (auto& parea : player_areas)
+        parea->setMiniLayout(best_cell_size);
+
+    const int rows = (count + best_cols - 1) / best_cols;
+    const int tile_width = player_areas.front()->width() + tile_padding;
+    const int tile_height = player_areas.front()->height() + tile_padding;
+    const int start_x = (screen_width - best_cols * tile_width + tile_padding) / 2;
+    const int start_y = (screen_height - rows * tile_height + tile_padding) / 2;
+
+    for (int i = 0; i < count; i++) {
+        player_areas[i]->setPosition(
+            start_x + (i % best_cols) * tile_width,
+            start_y + (i / best_cols) * tile_height);
+    }
+
+    if (tex_bg_wallpaper) {
+        const float wallpaper_scale = screen_height / (tex_bg_wallpaper->height() * 1.f);
+        rect_wallpaper.w = tex_bg_wallpaper->width() * wallpaper_scale;
+        rect_wallpaper.x = (screen_width - rect_wallpaper.w) / 2;
+        rect_wallpaper.y = 0;
+        rect_wallpaper.h = screen_height;
+    }
+}
+
 void IngameState::update(const std::vector<Event>& events, AppContext& app)
 {
-    std::unordered_map<DeviceID, std::vector<InputEvent>> input_events;
+    for (auto& event_vec : input_events)
+        event_vec.clear();
+
     for (const auto& event : events) {
         switch (event.type) {
             case EventType::WINDOW:
                 if (event.window == WindowEvent::RESIZED)
                     updatePositions(app);
                 break;
-            case EventType::INPUT:
-                input_events[event.input.srcDeviceID()].emplace_back(event.input);
+            case EventType::INPUT: {
+                const int slot = playerSlot(event.input.srcDeviceID());
+                if (slot >= 0 && static_cast<size_t>(slot) < input_events.size())
+                    input_events[slot].emplace_back(event.input);
                 break;
+            }
             default:
                 // TODO ?
                 break;
         }
     }
 
-    // if singleplayer, merge all input
-    if (isSinglePlayer(gamemode)) {
-        std::vector<InputEvent> temp = input_events[-1];
-        input_events.erase(-1);
-        for (const auto& event_vec : input_events)
-            temp.insert(temp.end(), event_vec.second.begin(), event_vec.second.end());
-        input_events.clear();
-        input_events.emplace(-1, std::move(temp));
-    }
-
-    for (auto& ui_pa : player_areas)
-        ui_pa.second.well().updateKeystateOnly(input_events[ui_pa.first]);
+    for (size_t slot = 0; slot < player_areas.size(); slot++)
+        player_areas[slot]->well().updateKeystateOnly(input_events[slot]);
 
     states.back()->update(*this, events, app);
 }
 
+void IngameState::updateAnimations(Duration elapsed)
+{
+    states.back()->updateAnimationsOnly(*this, elapsed);
+}
+
+bool IngameState::needsRedraw() const
+{
+    return states.back()->needsRedraw(*this);
+}
+
 void IngameState::draw(GraphicsContext& gcx)
 {
     drawCommon(gcx);
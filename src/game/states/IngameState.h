@@ -4,9 +4,10 @@
 #include "game/PlayerStatistics.h"
 #include "game/layout/gameplay/PlayerArea.h"
 
+#include <array>
 #include <list>
 #include <memory>
-#include <unordered_map>
+#include <vector>
 
 namespace SubStates { namespace Ingame {
     class State;
@@ -21,9 +22,11 @@ enum class GameMode : uint8_t {
     MP_MARATHON,
     MP_BATTLE,
     MP_MARATHON_SIMPLE,
+    MP_BATTLE_ROYALE,
 };
 
 bool isSinglePlayer(GameMode);
+bool isBattle(GameMode);
 
 class IngameState: public GameState {
 public:
@@ -31,15 +34,27 @@ public:
     ~IngameState();
 
     void update(const std::vector<Event>&, AppContext&) final;
+    void updateAnimations(Duration) final;
     void draw(GraphicsContext&) final;
+    bool needsRedraw() const final;
 
     void updatePositions(AppContext&);
 
+    /// The largest number of players in one game
+    static constexpr size_t max_player_count = 64;
+
+    /// Create the player areas and statistics for the devices of `device_order`.
+    /// The players are identified by their slot, their index in `device_order`.
+    void createPlayers(AppContext&, bool draw_gauge);
+    /// Returns the slot of the player controlled by the device, or -1 if there's none.
+    /// In single player modes, every device controls the first player.
+    int playerSlot(DeviceID device_id) const { return device_slots[static_cast<uint8_t>(device_id)]; }
+
     const GameMode gamemode;
     std::list<std::unique_ptr<SubStates::Ingame::State>> states;
     std::vector<DeviceID> device_order;
-    std::unordered_map<DeviceID, Layout::PlayerArea> player_areas;
-    std::unordered_map<DeviceID, PlayerStatistics> player_stats;
+    std::vector<std::unique_ptr<Layout::PlayerArea>> player_areas; ///< indexed by player slot
+    std::vector<PlayerStatistics> player_stats; ///< indexed by player slot
 
     const float draw_scale;
     const float draw_inverse_scale;
@@ -50,5 +65,9 @@ private:
 
     ::Rectangle rect_wallpaper;
 
+    std::array<int, 256> device_slots;
+    std::vector<std::vector<InputEvent>> input_events; ///< reused between frames
+
     void drawCommon(GraphicsContext&);
+    void tilePlayerAreas(AppContext&);
 };
@@ -12,18 +12,28 @@ MainMenuState::MainMenuState(AppContext& app)
     : padconnect_phase1(std::chrono::seconds(3), [](double){}, [this](){ padconnect_phase2.restart(); })
     , padconnect_phase2(std::chrono::seconds(3), [](double t){ return (1.0 - t) * 0xFF; })
     , tex_padconnected(app.gcx().loadTexture(Paths::data() + "gamepad-connect.png"))
+    , idle_time(Duration::zero())
 {
     padconnect_phase1.stop();
     padconnect_phase2.update(padconnect_phase2.length()); // set alpha to 0
     states.emplace_back(std::make_unique<SubStates::MainMenu::Base>(*this, app));
 }
 
+constexpr Duration MainMenuState::idle_timeout;
+
 MainMenuState::~MainMenuState() = default;
 
 void MainMenuState::update(const std::vector<Event>& events, AppContext& app)
 {
+    if (idle_time < idle_timeout)
+        idle_time += Timing::frame_duration;
+
     for (const auto& event : events) {
         switch (event.type) {
+            case EventType::INPUT:
+            case EventType::INPUT_RAW:
+                idle_time = Duration::zero();
+                break;
             case EventType::WINDOW:
                 switch (event.window) {
                     case WindowEvent::RESIZED:
@@ -41,6 +51,7 @@ void MainMenuState::update(const std::vector<Event>& events, AppContext& app)
                 }
                 break;
             case EventType::DEVICE:
+                idle_time = Duration::zero();
                 switch (event.device.type) {
                     case DeviceEventType::CONNECTED:
                         padconnect_phase1.restart();
@@ -69,6 +80,19 @@ void MainMenuState::reloadTheme(AppContext& app)
     static_cast<SubStates::MainMenu::Base*>(states.front().get())->reloadTheme(*this, app);
 }
 
+void MainMenuState::updateAnimations(Duration elapsed)
+{
+    // the base state is drawn below the others too
+    states.front()->updateAnimationsOnly(*this, elapsed);
+}
+
+bool MainMenuState::needsRedraw() const
+{
+    return padconnect_phase1.running()
+        || padconnect_phase2.running()
+        || states.back()->needsRedraw(*this);
+}
+
 void MainMenuState::draw(GraphicsContext& gcx)
 {
     states.back()->draw(*this, gcx);
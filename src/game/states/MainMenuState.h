@@ -14,14 +14,23 @@ public:
     MainMenuState(AppContext&);
     ~MainMenuState();
     void update(const std::vector<Event>&, AppContext&) final;
+    void updateAnimations(Duration) final;
     void draw(GraphicsContext&) final;
+    bool needsRedraw() const final;
 
     void reloadTheme(AppContext&);
 
+    /// Returns true if there was no user input for a while; the decorative
+    /// animations of the menu are stopped in this case
+    bool idle() const { return idle_time >= idle_timeout; }
+
     std::list<std::unique_ptr<SubStates::MainMenu::State>> states;
 
 private:
     Transition<void> padconnect_phase1; ///< phase 1: the popup is visible for a few seconds
     Transition<uint8_t> padconnect_phase2; ///< phase 2: the popup disappears in a few seconds
     std::unique_ptr<Texture> tex_padconnected;
+
+    static constexpr Duration idle_timeout = std::chrono::seconds(60);
+    Duration idle_time;
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "game/Timing.h"
 #include "system/Event.h"
 
 #include <vector>
@@ -15,10 +16,11 @@ namespace Ingame {
 class State {
 public:
     virtual ~State() {}
-    virtual void updateAnimationsOnly(IngameState&, AppContext&) {}
+    virtual void updateAnimationsOnly(IngameState&, Duration) {}
     virtual void update(IngameState&, const std::vector<Event>&, AppContext&) = 0;
     virtual void drawPassive(IngameState&, GraphicsContext&) const {}
     virtual void drawActive(IngameState&, GraphicsContext&) const {}
+    virtual bool needsRedraw(const IngameState&) const { return true; }
 };
 
 } // namespace Ingame
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "game/Timing.h"
 #include "system/Event.h"
 
 #include <vector>
@@ -15,10 +16,11 @@ namespace MainMenu {
 class State {
 public:
     virtual ~State() {}
-    virtual void updateAnimationsOnly(MainMenuState&, AppContext&) {}
+    virtual void updateAnimationsOnly(MainMenuState&, Duration) {}
     virtual void update(MainMenuState&, const std::vector<Event>&, AppContext&) = 0;
     virtual void updatePositions(GraphicsContext&) {};
     virtual void draw(MainMenuState&, GraphicsContext&) const {}
+    virtual bool needsRedraw(const MainMenuState&) const { return true; }
 };
 
 } // namespace MainMenu
@@ -55,13 +55,22 @@ void Countdown::update(IngameState& parent, const std::vector<Event>&, AppContex
     timer.update(Timing::frame_duration);
 }
 
-void Countdown::drawActive(IngameState& parent, GraphicsContext&) const
+void Countdown::drawActive(IngameState& parent, GraphicsContext& gcx) const
 {
     assert(current_idx < 3);
     const auto& tex = tex_countdown.at(current_idx);
+
+    // the mini wells are too small for the text, draw it only once
+    if (parent.player_areas.front()->isMini()) {
+        const int center_x = gcx.screenWidth() * parent.draw_inverse_scale / 2;
+        const int center_y = gcx.screenHeight() * parent.draw_inverse_scale / 2;
+        tex->drawAt(center_x - tex->width() / 2, center_y - tex->height() / 2);
+        return;
+    }
+
     for (const auto& ui_playerarea : parent.player_areas) {
-        const int center_x = ui_playerarea.second.wellCenterX();
-        const int center_y = ui_playerarea.second.wellCenterY();
+        const int center_x = ui_playerarea->wellCenterX();
+        const int center_y = ui_playerarea->wellCenterY();
         tex->drawAt(center_x - tex->width() / 2, center_y - tex->height() / 2);
     }
 }
@@ -8,7 +8,7 @@ namespace SubStates {
 namespace Ingame {
 namespace States {
 
-FadeIn::FadeIn(std::function<void()>&& on_end)
+FadeIn::FadeIn(Delegate<void()>&& on_end)
     : alpha(std::chrono::milliseconds(300),
             [](double t){ return (1.0 - t) * 0xFF; },
             std::move(on_end))
@@ -30,7 +30,7 @@ void FadeIn::drawActive(IngameState& parent, GraphicsContext& gcx) const
         color);
 }
 
-FadeOut::FadeOut(std::function<void()>&& on_end)
+FadeOut::FadeOut(Delegate<void()>&& on_end)
     : alpha(std::chrono::milliseconds(300),
             [](double t){ return t * 0xFF; },
             std::move(on_end))
@@ -10,7 +10,7 @@ namespace States {
 
 class FadeIn : public State {
 public:
-    FadeIn(std::function<void()>&& on_end);
+    FadeIn(Delegate<void()>&& on_end);
     void update(IngameState&, const std::vector<Event>&, AppContext&) final;
     void drawActive(IngameState&, GraphicsContext&) const final;
 
@@ -20,7 +20,7 @@ private:
 
 class FadeOut : public State {
 public:
-    FadeOut(std::function<void()>&& on_end);
+    FadeOut(Delegate<void()>&& on_end);
     void update(IngameState&, const std::vector<Event>&, AppContext&) final;
     void drawActive(IngameState&, GraphicsContext&) const final;
 
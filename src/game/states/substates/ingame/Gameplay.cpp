@@ -4,15 +4,18 @@
 #include "Pause.h"
 #include "Statistics.h"
 #include "game/AppContext.h"
-#include "game/BattleAttackTable.h"
 #include "game/components/HoldQueue.h"
 #include "game/components/NextQueue.h"
 #include "game/components/Piece.h"
 #include "game/components/animations/TextPopup.h"
 #include "game/states/IngameState.h"
+#include "game/trace/TraceRecorder.h"
+#include "game/util/AllocationCounter.h"
+#include "game/util/WorkerPool.h"
 #include "system/AudioContext.h"
 #include "system/Font.h"
 #include "system/Localize.h"
+#include "system/Log.h"
 #include "system/Music.h"
 #include "system/Paths.h"
 #include "system/SoundEffect.h"
@@ -20,12 +23,75 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <thread>
 
 
 namespace SubStates {
 namespace Ingame {
 namespace States {
 
+namespace {
+const std::string LOG_TAG("gameplay");
+
+/// Fails if the main thread has allocated since `allocations_before`, in debug builds.
+/// The gameplay frames must never allocate.
+void checkAllocations(uint64_t allocations_before, const char* where)
+{
+#ifndef NDEBUG
+    const uint64_t allocations = AllocationCounter::count() - allocations_before;
+    if (allocations > 0)
+        Log::error(LOG_TAG) << allocations << " heap allocations in " << where << "\n";
+    assert(allocations == 0);
+#else
+    (void) allocations_before;
+    (void) where;
+#endif
+}
+
+/// Returns the scoring rules of the game mode. The simple modes count only the
+/// cleared lines, the others use the rule set chosen in the options.
+const ScoreRules& modeScoreRules(GameMode gamemode, const WellConfig& config)
+{
+    switch (gamemode) {
+        case GameMode::SP_MARATHON_SIMPLE:
+        case GameMode::MP_MARATHON_SIMPLE:
+            return ScoreTable::rules(ScoreRuleSet::CLASSIC);
+        default:
+            break;
+    }
+
+    if (config.score_rules == ScoreRuleSet::CUSTOM)
+        return config.custom_score_rules;
+
+    return ScoreTable::rules(config.score_rules);
+}
+
+/// Returns the team of every player slot. Without a team setup,
+/// everyone plays for themselves.
+std::vector<size_t> playerTeams(const std::vector<DeviceID>& devices,
+                                const std::unordered_map<DeviceID, size_t>& team_setup)
+{
+    std::vector<size_t> teams(devices.size());
+    for (size_t slot = 0; slot < devices.size(); slot++)
+        teams[slot] = team_setup.empty() ? slot : team_setup.at(devices[slot]);
+    return teams;
+}
+} // namespace
+
+Gameplay::Player::Player()
+    : lineclears_left(0)
+    , previous_lineclear_type(ScoreType::CLEAR_SINGLE)
+    , back2back_length(0)
+    , combo_length(0)
+    , prev_piece_cleared_line(false)
+    , current_piece_cleared_line(false)
+    , arrived_garbage_row_count(0)
+    , hold_pending(false)
+    , status(PlayerStatus::PLAYING)
+    , team(0)
+{}
+
 Gameplay::Gameplay(AppContext& app, IngameState& parent, unsigned short starting_gravity_level, std::unordered_map<DeviceID, size_t>&& team_setup)
     : player_devices(parent.device_order)
     , theme_settings(app.theme().gameplay)
@@ -45,42 +111,57 @@ Gameplay::Gameplay(AppContext& app, IngameState& parent, unsigned short starting
     , texts_need_update(true)
     , sfx_ongameover(app.audio().loadSound(app.theme().get_sfx("gameover.ogg")))
     , sfx_onfinish(app.audio().loadSound(app.theme().get_sfx("finish.ogg")))
+    , next_attackanim(0)
     , gameend_statistics_delay(std::chrono::seconds(5),
         [](double t){ return t * 5; },
         [&parent, &app](){
             parent.states.emplace_back(std::make_unique<Statistics>(parent, app));
         })
-    , player_team(std::move(team_setup))
+    , players(player_devices.size())
+    , input_events(player_devices.size())
+    , tracer(app.tracer())
+    , score_rules(modeScoreRules(parent.gamemode, app.wellconfig()))
+    , targeting(app.wellconfig().battle_targeting, playerTeams(parent.device_order, team_setup), 0)
+    , garbage_hole_rng()
+    , garbage_delay(app.wellconfig().garbage_delay)
+    , battle_frame(0)
 {
     TextPopup::text_color = app.theme().colors.popup;
+    font_popuptext->preloadAsciiGlyphs();
 
     assert(player_devices.size() > 0);
-    assert(player_devices.size() <= 4);
+    assert(player_devices.size() <= IngameState::max_player_count);
     assert(starting_gravity_level < 15);
-    assert(player_team.size() == 0 || player_team.size() == player_devices.size());
-    parent.player_areas.clear();
-    parent.player_stats.clear();
+    assert(team_setup.size() == 0 || team_setup.size() == player_devices.size());
 
 
-    const bool is_battle = (parent.gamemode == GameMode::MP_BATTLE);
+    const bool is_battle = isBattle(parent.gamemode);
+    parent.createPlayers(app, is_battle);
 
-    for (const DeviceID device_id : player_devices) {
-        previous_lineclear_type[device_id] = ScoreType::CLEAR_SINGLE;
-        back2back_length[device_id] = 0;
-        combo_length[device_id] = 0;
-        current_piece_cleared_line[device_id] = false;
-        prev_piece_cleared_line[device_id] = false;
-        pending_garbage_lines[device_id] = 0;
+    // every random choice of the game is derived from the piece sequence's seed,
+    // so the game can be reproduced regardless of how the wells were updated
+    std::seed_seq game_seed {NextQueue::sequenceSeed()};
+    std::vector<uint32_t> seeds(2 + players.size());
+    game_seed.generate(seeds.begin(), seeds.end());
+    targeting.setSeed(seeds[0]);
+    garbage_hole_rng.seed(seeds[1]);
 
-        player_status[device_id] = PlayerStatus::PLAYING;
-        parent.player_areas.emplace(std::piecewise_construct,
-                std::forward_as_tuple(device_id), std::forward_as_tuple(app, is_battle));
-        parent.player_stats.emplace(std::piecewise_construct,
-            std::forward_as_tuple(device_id), std::forward_as_tuple());
-
-        textpopups.emplace(std::piecewise_construct,
-            std::forward_as_tuple(device_id), std::forward_as_tuple());
+    const auto teams = playerTeams(player_devices, team_setup);
+    for (size_t slot = 0; slot < players.size(); slot++) {
+        players[slot].team = teams[slot];
+        parent.player_areas[slot]->well().setGarbageSeed(seeds[2 + slot]);
+        parent.player_areas[slot]->well().createSparePieces();
+    }
+    playing_players.reserve(players.size());
+    popup_text.reserve(TextPopup::max_text_length);
+
+    if (app.sysconfig().parallel_wells && players.size() > 1) {
+        const unsigned hw_threads = std::max(1u, std::thread::hardware_concurrency());
+        const unsigned thread_count = std::min<unsigned>(hw_threads, players.size()) - 1;
+        if (thread_count > 0)
+            workers = std::make_unique<WorkerPool>(thread_count);
     }
+
     {
         // TODO: consider alternative algorithm
         std::stack<Duration> gravity_stack;
@@ -89,10 +170,10 @@ Gameplay::Gameplay(AppContext& app, IngameState& parent, unsigned short starting
             gravity_stack.push(std::chrono::duration_cast<Duration>(multiplier * std::chrono::seconds(1)));
         }
 
-        for (const DeviceID device_id : player_devices) {
-            gravity_levels[device_id] = gravity_stack;
-            parent.player_areas.at(device_id).well().setGravity(gravity_stack.top());
-            gravity_levels[device_id].pop();
+        for (size_t slot = 0; slot < players.size(); slot++) {
+            players[slot].gravity_levels = gravity_stack;
+            parent.player_areas[slot]->well().setGravity(gravity_stack.top());
+            players[slot].gravity_levels.pop();
         }
     }
     {
@@ -110,16 +191,16 @@ Gameplay::Gameplay(AppContext& app, IngameState& parent, unsigned short starting
             }
         }
 
-        for (const DeviceID device_id : player_devices) {
-            lineclears_required[device_id] = lineclear_stack;
-            lineclears_left[device_id] = lineclear_stack.top();
-            lineclears_required[device_id].pop();
+        for (auto& player : players) {
+            player.lineclears_required = lineclear_stack;
+            player.lineclears_left = lineclear_stack.top();
+            player.lineclears_required.pop();
         }
     }
 
     if (is_battle) {
         for (auto& parea : parent.player_areas)
-            parea.second.enableGameOverSFX(false);
+            parea->enableGameOverSFX(false);
     }
 
     parent.updatePositions(app);
@@ -134,58 +215,95 @@ Gameplay::Gameplay(AppContext& app, IngameState& parent, unsigned short starting
 
 Gameplay::~Gameplay() = default;
 
-void Gameplay::addNextPiece(IngameState& parent, DeviceID device_id)
+void Gameplay::addNextPiece(IngameState& parent, size_t slot)
 {
-    auto& parea = parent.player_areas.at(device_id);
+    auto& parea = *parent.player_areas[slot];
     parea.well().addPiece(parea.nextQueue().next());
     parea.holdQueue().onNextTurn();
+
+    auto& player = players[slot];
+    if (player.hold_pending && parea.well().activePiece()) {
+        player.hold_pending = false;
+        holdPiece(parent, slot);
+    }
+}
+
+void Gameplay::holdPiece(IngameState& parent, size_t slot)
+{
+    auto& well = parent.player_areas[slot]->well();
+    auto& hold_queue = parent.player_areas[slot]->holdQueue();
+    assert(well.activePiece());
+
+    hold_queue.onSwapRequested();
+    if (hold_queue.swapAllowed()) {
+        auto type = well.activePiece()->type();
+        well.deletePiece();
+        if (hold_queue.isEmpty()) {
+            hold_queue.swapWithEmpty(type);
+            addNextPiece(parent, slot);
+        }
+        else
+            well.addPiece(hold_queue.swapWith(type));
+
+        sfx_onhold->playOnce();
+    }
 }
 
 
-std::vector<DeviceID> Gameplay::playingPlayers()
+bool Gameplay::anyonePlaying() const
 {
-    std::vector<DeviceID> playing_players;
-    for (const DeviceID pdevid : player_devices) {
-        if (player_status.at(pdevid) == PlayerStatus::PLAYING)
-            playing_players.push_back(pdevid);
+    return std::any_of(players.cbegin(), players.cend(),
+        [](const Player& player){ return player.status == PlayerStatus::PLAYING; });
+}
+
+void Gameplay::collectPlayingPlayers()
+{
+    playing_players.clear();
+    for (size_t slot = 0; slot < players.size(); slot++) {
+        if (players[slot].status == PlayerStatus::PLAYING)
+            playing_players.push_back(slot);
     }
-    return playing_players;
 }
 
-void Gameplay::increaseScoreMaybe(IngameState& parent, DeviceID source_player,
+void Gameplay::increaseScoreMaybe(IngameState& parent, size_t slot,
                                   const WellEvent::lineclear_t& lcevent)
 {
+    auto& player = players[slot];
     const auto score_type = ScoreTable::lineclearType(lcevent);
-    std::string popup_text = ScoreTable::name(score_type);
+    popup_text = ScoreTable::name(score_type);
 
-    auto& player_stats = parent.player_stats.at(source_player);
+    auto& player_stats = parent.player_stats[slot];
     player_stats.event_count[score_type]++;
     player_stats.total_cleared_lines += lcevent.count;
 
 
-    unsigned score = ScoreTable::value(score_type);
-    const bool back2back = ScoreTable::canContinueBackToBack(previous_lineclear_type.at(source_player), score_type);
+    unsigned score = score_rules.value(score_type);
+    const bool back2back = score_rules.canContinueBackToBack(player.previous_lineclear_type, score_type);
     if (back2back) {
-        score *= ScoreTable::back2backMultiplier();
-        popup_text = ScoreTable::back2backName() + "\n" + popup_text;
-        back2back_length.at(source_player)++;
+        score *= score_rules.back2back_multiplier;
+        popup_text.insert(0, "\n");
+        popup_text.insert(0, ScoreTable::back2backName());
+        player.back2back_length++;
         player_stats.back_to_back_count++;
         player_stats.back_to_back_longest = std::max(player_stats.back_to_back_longest,
-                                                    back2back_length.at(source_player));
+                                                    player.back2back_length);
     }
     else
-        back2back_length.at(source_player) = 0;
+        player.back2back_length = 0;
 
     if (score_type != ScoreType::CLEAR_SINGLE)
-        textpopups.at(source_player).emplace_back(popup_text, font_popuptext);
+        player.textpopups.push(popup_text, font_popuptext);
 
 
-    auto& combo_count = combo_length.at(source_player);
-    if (prev_piece_cleared_line.at(source_player)) {
+    auto& combo_count = player.combo_length;
+    if (player.prev_piece_cleared_line) {
         combo_count++;
-        score += ScoreTable::value(ScoreType::COMBO);
-        popup_text = std::to_string(combo_count) + ScoreTable::name(ScoreType::COMBO);
-        textpopups.at(source_player).emplace_back(popup_text, font_popuptext);
+        score += score_rules.value(ScoreType::COMBO);
+        if (score_rules.value(ScoreType::COMBO)) {
+            popup_text.assign(std::to_string(combo_count));
+            popup_text.append(ScoreTable::name(ScoreType::COMBO));
+            player.textpopups.push(popup_text, font_popuptext);
+        }
     }
     else
         combo_count = 0;
@@ -194,54 +312,48 @@ void Gameplay::increaseScoreMaybe(IngameState& parent, DeviceID source_player,
     player_stats.score += score * player_stats.level;
 }
 
-void Gameplay::sendGarbageMaybe(IngameState& parent, DeviceID source_player,
+void Gameplay::sendGarbageMaybe(IngameState& parent, size_t source_slot,
                                 const WellEvent::lineclear_t& lcevent)
 {
-    if (parent.gamemode != GameMode::MP_BATTLE)
+    if (!isBattle(parent.gamemode))
         return;
 
+    auto& source_player = players[source_slot];
     const auto score_type = ScoreTable::lineclearType(lcevent);
-    const bool back2back = ScoreTable::canContinueBackToBack(previous_lineclear_type.at(source_player), score_type);
-    unsigned sendable_lines = BattleAttackTable::sendableLineCount(lcevent, back2back);
+    const bool back2back = score_rules.canContinueBackToBack(source_player.previous_lineclear_type, score_type);
+    unsigned sendable_lines = score_rules.sendableLineCount(score_type, back2back);
 
     if (sendable_lines > 0) {
-        // reduce current garbage
-        auto& parea = parent.player_areas.at(source_player);
-        unsigned current_queue = parea.queuedGarbageLines();
-        const unsigned smallest = std::min(sendable_lines, current_queue);
-        current_queue -= smallest;
-        sendable_lines -= smallest;
-        parea.setGarbageCount(current_queue);
-        pending_garbage_lines.at(source_player) = current_queue;
+        // reduce the incoming garbage, starting with the first to arrive
+        sendable_lines -= source_player.incoming_garbage.cancel(sendable_lines);
+        parent.player_areas[source_slot]->setGarbageCount(source_player.incoming_garbage.totalLines());
     }
 
     // if we can still send some lines
     if (sendable_lines > 0) {
-        // find target player
-        std::vector<DeviceID> possible_players;
-        for (const DeviceID possible_device : player_devices) {
-            if (player_status.at(possible_device) == PlayerStatus::PLAYING && player_team.at(possible_device) != player_team.at(source_player))
-                possible_players.push_back(possible_device);
-        }
-        assert(!possible_players.empty());
+        const size_t target_slot = targeting.selectTarget(source_slot);
+        if (target_slot == BattleTargeting::no_target)
+            return;
+        assert(target_slot != source_slot);
 
-        std::random_shuffle(possible_players.begin(), possible_players.end());
-        DeviceID target_id = possible_players.front();
-        assert(target_id != source_player);
+        const auto& src_parea = *parent.player_areas[source_slot];
+        const auto& dst_parea = *parent.player_areas[target_slot];
+        // the wells may be in the same column in the tiled layout
+        const int distance = std::max(1, std::abs(dst_parea.wellCenterX() - src_parea.wellCenterX()))
+            * (dst_parea.wellCenterX() < src_parea.wellCenterX() ? -1 : 1);
 
-        const auto& src_parea = parent.player_areas.at(source_player);
-        const auto& dst_parea = parent.player_areas.at(target_id);
-        const int distance = dst_parea.wellCenterX() - src_parea.wellCenterX();
-        assert(distance != 0);
+        if (tracer)
+            tracer->recordGarbageQueued(player_devices[target_slot], sendable_lines);
 
-        attackanims.emplace_back(
+        auto& target_garbage = players[target_slot].incoming_garbage;
+        const unsigned hole_column = std::uniform_int_distribution<unsigned>(0, Well::matrix_cols - 1)(garbage_hole_rng);
+        target_garbage.push(source_slot, sendable_lines, battle_frame + garbage_delay, hole_column);
+        parent.player_areas[target_slot]->setGarbageCount(target_garbage.totalLines());
+
+        attackanims[next_attackanim].start(
             src_parea.wellCenterX(), distance,
-            src_parea.wellBox().y, src_parea.wellBox().y + src_parea.wellBox().h,
-            [this, &parent, target_id, sendable_lines](){
-                auto& target_player = parent.player_areas.at(target_id);
-                target_player.setGarbageCount(target_player.queuedGarbageLines() + sendable_lines);
-                sfx_ongarbageadded->playOnce();
-            });
+            src_parea.wellBox().y, src_parea.wellBox().y + src_parea.wellBox().h);
+        next_attackanim = (next_attackanim + 1) % attackanims.size();
     }
 }
 
@@ -257,26 +369,27 @@ bool Gameplay::usesDynamicLineAwards(IngameState& parent)
     }
 }
 
-void Gameplay::increaseLevelMaybe(IngameState& parent, DeviceID source_player,
+void Gameplay::increaseLevelMaybe(IngameState& parent, size_t slot,
                                   const WellEvent::lineclear_t& lcevent)
 {
-    auto& lines_left = lineclears_left.at(source_player);
+    auto& player = players[slot];
+    auto& lines_left = player.lineclears_left;
     int line_awards = lcevent.count;
     if (usesDynamicLineAwards(parent)) {
         const auto clear_type = ScoreTable::lineclearType(lcevent);
-        line_awards = ScoreTable::lineAwards(clear_type);
+        line_awards = score_rules.lineAwards(clear_type);
 
-        if (ScoreTable::canContinueBackToBack(previous_lineclear_type.at(source_player), clear_type))
-            line_awards *= ScoreTable::back2backMultiplier();
+        if (score_rules.canContinueBackToBack(player.previous_lineclear_type, clear_type))
+            line_awards *= score_rules.back2back_multiplier;
 
-        line_awards += combo_length.at(source_player) / 2;
+        line_awards += player.combo_length / 2;
     }
     lines_left -= line_awards;
 
     while (lines_left <= 0) {
-        auto& parea = parent.player_areas.at(source_player);
-        auto& gravity_stack = gravity_levels.at(source_player);
-        auto& line_req_stack = lineclears_required.at(source_player);
+        auto& parea = *parent.player_areas[slot];
+        auto& gravity_stack = player.gravity_levels;
+        auto& line_req_stack = player.lineclears_required;
 
         if (line_req_stack.empty() || gravity_stack.empty()) {
             lines_left = 0;
@@ -284,13 +397,13 @@ void Gameplay::increaseLevelMaybe(IngameState& parent, DeviceID source_player,
                 || parent.gamemode == GameMode::MP_MARATHON
                 || parent.gamemode == GameMode::MP_MARATHON_SIMPLE);
             if (finishable) {
-                player_status.at(source_player) = PlayerStatus::FINISHED;
+                player.status = PlayerStatus::FINISHED;
                 parea.startGameFinish();
                 sfx_onfinish->playOnce();
                 gameend_statistics_delay.restart();
 
                 // find out who else is still playing
-                if (playingPlayers().empty())
+                if (!anyonePlaying())
                     music->fadeOut(std::chrono::seconds(1));
             }
             return;
@@ -300,57 +413,66 @@ void Gameplay::increaseLevelMaybe(IngameState& parent, DeviceID source_player,
         gravity_stack.pop();
         lines_left += line_req_stack.top();
         line_req_stack.pop();
-        parent.player_stats.at(source_player).level++;
+        parent.player_stats[slot].level++;
 
         sfx_onlevelup->playOnce();
-        textpopups.at(source_player).emplace_back(tr("LEVEL UP!"), font_popuptext);
+        player.textpopups.push(tr("LEVEL UP!"), font_popuptext);
     }
 }
 
-void Gameplay::registerObservers(IngameState& parent, AppContext& app)
+void Gameplay::registerObservers(IngameState& parent, AppContext&)
 {
-    for (const DeviceID device_id : player_devices) {
-        auto& well = parent.player_areas.at(device_id).well();
+    for (size_t slot = 0; slot < players.size(); slot++) {
+        auto& well = parent.player_areas[slot]->well();
+
+        if (tracer) {
+            // registered first, so the events are recorded before they are handled
+            const DeviceID device_id = player_devices[slot];
+            for (unsigned type = 0; type < WellEvent::type_count; type++) {
+                well.registerObserver(static_cast<WellEvent::Type>(type), [this, device_id](const WellEvent& event){
+                    tracer->recordWellEvent(device_id, event);
+                });
+            }
+        }
 
-        well.registerObserver(WellEvent::Type::PIECE_LOCKED, [this, &parent, device_id](const WellEvent&){
+        well.registerObserver(WellEvent::Type::PIECE_LOCKED, [this, slot](const WellEvent&){
             sfx_onlock->playOnce();
 
-            prev_piece_cleared_line.at(device_id) = current_piece_cleared_line.at(device_id);
-            current_piece_cleared_line.at(device_id) = false;
+            auto& player = players[slot];
+            player.prev_piece_cleared_line = player.current_piece_cleared_line;
+            player.current_piece_cleared_line = false;
         });
 
         well.registerObserver(WellEvent::Type::PIECE_ROTATED, [this](const WellEvent&){
             sfx_onrotate->playOnce();
         });
 
-        well.registerObserver(WellEvent::Type::NEXT_REQUESTED, [this, &parent, device_id](const WellEvent&){
-            if (player_status.at(device_id) != PlayerStatus::PLAYING)
+        well.registerObserver(WellEvent::Type::NEXT_REQUESTED, [this, &parent, slot](const WellEvent&){
+            if (players[slot].status != PlayerStatus::PLAYING)
                 return;
 
-            auto& parea = parent.player_areas.at(device_id);
-            pending_garbage_lines.at(device_id) = parea.queuedGarbageLines();
-            parea.setGarbageCount(0);
+            auto& parea = *parent.player_areas[slot];
+            // a hold swap queued earlier in the frame may have already added a piece
+            if (parea.well().activePiece())
+                return;
 
-            addNextPiece(parent, device_id);
-        });
+            auto& player = players[slot];
+            player.arrived_garbage_row_count = player.incoming_garbage.popArrived(battle_frame,
+                Well::matrix_cols, player.arrived_garbage_rows.data(), player.arrived_garbage_rows.size());
+            parea.setGarbageCount(player.incoming_garbage.totalLines());
 
-        well.registerObserver(WellEvent::Type::HOLD_REQUESTED, [this, &parent, device_id](const WellEvent&){
-            auto& well = parent.player_areas.at(device_id).well();
-            auto& hold_queue = parent.player_areas.at(device_id).holdQueue();
-
-            hold_queue.onSwapRequested();
-            if (hold_queue.swapAllowed()) {
-                auto type = well.activePiece()->type();
-                well.deletePiece();
-                if (hold_queue.isEmpty()) {
-                    hold_queue.swapWithEmpty(type);
-                    addNextPiece(parent, device_id);
-                }
-                else
-                    well.addPiece(hold_queue.swapWith(type));
+            addNextPiece(parent, slot);
+        });
 
-                sfx_onhold->playOnce();
+        well.registerObserver(WellEvent::Type::HOLD_REQUESTED, [this, &parent, slot](const WellEvent&){
+            // the piece may have been locked later in the same frame,
+            // or a line clear is in progress; hold the next piece instead
+            if (!parent.player_areas[slot]->well().activePiece()) {
+                players[slot].hold_pending = true;
+                return;
             }
+
+            holdPiece(parent, slot);
         });
 
         well.registerObserver(WellEvent::Type::LINE_CLEAR_ANIMATION_START, [this](const WellEvent& event){
@@ -360,72 +482,73 @@ void Gameplay::registerObservers(IngameState& parent, AppContext& app)
             sfx_onlineclear.at(event.lineclear.count - 1)->playOnce();
         });
 
-        well.registerObserver(WellEvent::Type::LINE_CLEAR, [this, &parent, &app, device_id](const WellEvent& event){
+        well.registerObserver(WellEvent::Type::LINE_CLEAR, [this, &parent, slot](const WellEvent& event){
             assert(event.type == WellEvent::Type::LINE_CLEAR);
             assert(event.lineclear.count > 0);
             assert(event.lineclear.count <= 4);
 
-            increaseScoreMaybe(parent, device_id, event.lineclear);
-            sendGarbageMaybe(parent, device_id, event.lineclear);
-            increaseLevelMaybe(parent, device_id, event.lineclear);
+            increaseScoreMaybe(parent, slot, event.lineclear);
+            sendGarbageMaybe(parent, slot, event.lineclear);
+            increaseLevelMaybe(parent, slot, event.lineclear);
 
-            previous_lineclear_type.at(device_id) = ScoreTable::lineclearType(event.lineclear);
-            current_piece_cleared_line.at(device_id) = true;
+            players[slot].previous_lineclear_type = ScoreTable::lineclearType(event.lineclear);
+            players[slot].current_piece_cleared_line = true;
             texts_need_update = true;
         });
 
-        well.registerObserver(WellEvent::Type::MINI_TSPIN_DETECTED, [this, &parent, device_id](const WellEvent&){
+        well.registerObserver(WellEvent::Type::MINI_TSPIN_DETECTED, [this, &parent, slot](const WellEvent&){
             texts_need_update = true;
-            auto& player_stats = parent.player_stats.at(device_id);
-            player_stats.score += ScoreTable::value(ScoreType::MINI_TSPIN);
+            auto& player_stats = parent.player_stats[slot];
+            player_stats.score += score_rules.value(ScoreType::MINI_TSPIN);
             player_stats.event_count[ScoreType::MINI_TSPIN]++;
 
-            textpopups.at(device_id).emplace_back(ScoreTable::name(ScoreType::MINI_TSPIN), font_popuptext);
+            players[slot].textpopups.push(ScoreTable::name(ScoreType::MINI_TSPIN), font_popuptext);
         });
 
-        well.registerObserver(WellEvent::Type::TSPIN_DETECTED, [this, &parent, device_id](const WellEvent&){
+        well.registerObserver(WellEvent::Type::TSPIN_DETECTED, [this, &parent, slot](const WellEvent&){
             texts_need_update = true;
-            auto& player_stats = parent.player_stats.at(device_id);
-            player_stats.score += ScoreTable::value(ScoreType::TSPIN);
+            auto& player_stats = parent.player_stats[slot];
+            player_stats.score += score_rules.value(ScoreType::TSPIN);
             player_stats.event_count[ScoreType::TSPIN]++;
 
-            textpopups.at(device_id).emplace_back(ScoreTable::name(ScoreType::TSPIN), font_popuptext);
+            players[slot].textpopups.push(ScoreTable::name(ScoreType::TSPIN), font_popuptext);
         });
 
-        well.registerObserver(WellEvent::Type::HARDDROPPED, [this, &parent, device_id](const WellEvent& event){
+        well.registerObserver(WellEvent::Type::HARDDROPPED, [this, &parent, slot](const WellEvent& event){
             assert(event.harddrop.count < 22);
             texts_need_update = true;
-            auto& player_stats = parent.player_stats.at(device_id);
-            player_stats.score += event.harddrop.count * ScoreTable::value(ScoreType::HARDDROP);
+            auto& player_stats = parent.player_stats[slot];
+            player_stats.score += event.harddrop.count * score_rules.value(ScoreType::HARDDROP);
         });
 
-        well.registerObserver(WellEvent::Type::SOFTDROPPED, [this, &parent, device_id](const WellEvent&){
+        well.registerObserver(WellEvent::Type::SOFTDROPPED, [this, &parent, slot](const WellEvent&){
             texts_need_update = true;
-            auto& player_stats = parent.player_stats.at(device_id);
-            player_stats.score += ScoreTable::value(ScoreType::SOFTDROP);
+            auto& player_stats = parent.player_stats[slot];
+            player_stats.score += score_rules.value(ScoreType::SOFTDROP);
         });
 
-        well.registerObserver(WellEvent::Type::GAME_OVER, [this, &parent, &app, device_id](const WellEvent&){
+        well.registerObserver(WellEvent::Type::GAME_OVER, [this, &parent, slot](const WellEvent&){
             // set game over for the triggering player
-            player_status.at(device_id) = PlayerStatus::GAME_OVER;
-            parent.player_areas.at(device_id).startGameOver();
+            players[slot].status = PlayerStatus::GAME_OVER;
+            parent.player_areas[slot]->startGameOver();
+            targeting.removePlayer(slot);
 
             // find out who else is still playing
-            std::vector<DeviceID> playing_players = playingPlayers();
+            collectPlayingPlayers();
 
             // IF MARATHON
                 // wait until all players finish the game
             // IF BATTLE
-            if (parent.gamemode == GameMode::MP_BATTLE) {
-                std::unordered_map<size_t, size_t> team_player_count;
-                for (DeviceID player : playing_players)
-                    team_player_count[player_team.at(player)]++;
+            if (isBattle(parent.gamemode) && !playing_players.empty()) {
+                const size_t first_team = players[playing_players.front()].team;
+                const bool one_team_left = std::all_of(playing_players.cbegin(), playing_players.cend(),
+                    [this, first_team](size_t player){ return players[player].team == first_team; });
 
                 // if there's only one team left, they are the winner
-                if (team_player_count.size() == 1) {
-                    for (DeviceID player : playing_players) {
-                        player_status.at(player) = PlayerStatus::FINISHED;
-                        parent.player_areas.at(player).startGameFinish();
+                if (one_team_left) {
+                    for (size_t player : playing_players) {
+                        players[player].status = PlayerStatus::FINISHED;
+                        parent.player_areas[player]->startGameFinish();
                         sfx_onfinish->playOnce();
                     }
                     playing_players.clear();
@@ -441,41 +564,37 @@ void Gameplay::registerObservers(IngameState& parent, AppContext& app)
     } // end of `for`
 }
 
-void Gameplay::updateAnimationsOnly(IngameState& parent, AppContext&)
+void Gameplay::updateAnimationsOnly(IngameState& parent, Duration elapsed)
 {
-    for (const DeviceID device_id : player_devices) {
-        auto& parea = parent.player_areas.at(device_id);
-        parea.well().updateAnimationsOnly();
+    const uint64_t allocations_before = AllocationCounter::count();
 
-        auto& popups = textpopups.at(device_id);
+    for (size_t slot = 0; slot < players.size(); slot++) {
+        auto& parea = *parent.player_areas[slot];
+        parea.well().updateAnimationsOnly(elapsed);
 
-        // remove old animations
-        while (!popups.empty() && !popups.front().isActive())
-            popups.pop_front();
-
-        // newly created popups don't know their position
+        // the popups appear next to the well
         const int center_x = parea.x() - 10
             + (parea.wellBox().x - 10 - parea.x()) / 2;
-        for (auto& popup : popups) {
-            popup.setInitialPosition(
-                center_x - static_cast<int>(popup.width()) / 2,
-                parea.y() + parea.height() / 2
-            );
-            popup.update();
-            if (popup.visibility() > (0.6 * 0xFF))
-                break;
-        }
+        players[slot].textpopups.update(elapsed, center_x, parea.y() + parea.height() / 2);
+    }
+
+    for (auto& anim : attackanims) {
+        if (!anim.isActive())
+            continue;
+
+        anim.update(elapsed);
+        if (!anim.isActive())
+            sfx_ongarbageadded->playOnce();
     }
 
-    attackanims.remove_if([](BattleAttackAnim& anim){ return !anim.isActive(); });
-    for (auto& anim : attackanims)
-        anim.update();
+    checkAllocations(allocations_before, "the gameplay animations");
 }
 
 void Gameplay::update(IngameState& parent, const std::vector<Event>& events, AppContext& app)
 {
-    const bool someone_still_playing = !playingPlayers().empty();
-    std::unordered_map<DeviceID, std::vector<InputEvent>> input_events;
+    const bool someone_still_playing = anyonePlaying();
+    for (auto& event_vec : input_events)
+        event_vec.clear();
 
     for (const auto& event : events) {
         switch (event.type) {
@@ -493,7 +612,10 @@ void Gameplay::update(IngameState& parent, const std::vector<Event>& events, App
                         parent.states.emplace_back(std::make_unique<Pause>(app));
                         return;
                     }
-                    input_events[event.input.srcDeviceID()].emplace_back(event.input);
+                    // in single player, every device controls the player
+                    const int slot = parent.playerSlot(event.input.srcDeviceID());
+                    if (slot >= 0)
+                        input_events[slot].emplace_back(event.input);
                 }
                 else if (gameend_statistics_delay.value() > 1) {
                     // allow input only after at least one second has passed
@@ -507,39 +629,15 @@ void Gameplay::update(IngameState& parent, const std::vector<Event>& events, App
 
     gameend_statistics_delay.update(Timing::frame_duration);
 
-    // if singleplayer, merge all input
-    if (player_devices.size() == 1) {
-        std::vector<InputEvent> temp = input_events[-1];
-        input_events.erase(-1);
-        for (const auto& event_vec : input_events)
-            temp.insert(temp.end(), event_vec.second.begin(), event_vec.second.end());
-        input_events.clear();
-        input_events.emplace(-1, std::move(temp));
-    }
-
-    for (const DeviceID device_id : player_devices) {
-        if (player_status.at(device_id) == PlayerStatus::PLAYING) {
-            auto& parea = parent.player_areas.at(device_id);
-            auto& well = parea.well();
-
-            well.updateGameplayOnly(input_events[device_id]);
-            well.addGarbageLines(pending_garbage_lines.at(device_id));
-            pending_garbage_lines.at(device_id) = 0;
-
-            auto& stats = parent.player_stats.at(device_id);
-            stats.gametime += Timing::frame_duration;
-            parea.setGametime(stats.gametime);
-        }
-        parent.player_areas.at(device_id).update();
-    }
+    const uint64_t allocations_before = AllocationCounter::count();
+    updateWells(parent);
 
     if (parent.gamemode == GameMode::SP_2MIN && someone_still_playing) {
-        assert(parent.device_order.size() == 1);
-        const DeviceID device_id = parent.device_order.front();
-        const auto gametime = parent.player_stats.at(device_id).gametime;
+        assert(players.size() == 1);
+        const auto gametime = parent.player_stats.front().gametime;
         if (gametime >= std::chrono::minutes(2)) {
-            player_status.at(device_id) = PlayerStatus::FINISHED;
-            parent.player_areas.at(device_id).startGameFinish();
+            players.front().status = PlayerStatus::FINISHED;
+            parent.player_areas.front()->startGameFinish();
             sfx_onfinish->playOnce();
             gameend_statistics_delay.restart();
             music->fadeOut(std::chrono::seconds(1));
@@ -547,32 +645,76 @@ void Gameplay::update(IngameState& parent, const std::vector<Event>& events, App
     }
 
     if (texts_need_update) {
-        for (const DeviceID device_id : player_devices) {
-            const auto& stats = parent.player_stats.at(device_id);
-            auto& parea = parent.player_areas.at(device_id);
-            parea.setGoalCounter(lineclears_left.at(device_id));
+        for (size_t slot = 0; slot < players.size(); slot++) {
+            const auto& stats = parent.player_stats[slot];
+            auto& parea = *parent.player_areas[slot];
+            parea.setGoalCounter(players[slot].lineclears_left);
             parea.setLevelCounter(app.theme().gameplay.draw_labels, stats.level);
             parea.setScore(stats.score);
         }
         texts_need_update = false;
     }
 
-    // updating the Well may produce popups, initialized at (0;0),
-    // so we update the animations only after that
-    updateAnimationsOnly(parent, app);
+    checkAllocations(allocations_before, "the gameplay update");
 }
 
-void Gameplay::drawPassive(IngameState& parent, GraphicsContext& gcx) const
+void Gameplay::updateWells(IngameState& parent)
 {
-    for (const auto& parea : parent.player_areas)
-        parea.second.drawPassive(gcx);
+    battle_frame++;
 
-    for (const auto& popup_vec : textpopups) {
-        for (const auto& popup : popup_vec.second) {
-            popup.draw();
+    if (tracer) {
+        for (size_t slot = 0; slot < players.size(); slot++) {
+            const auto& player = players[slot];
+            if (player.status == PlayerStatus::PLAYING && player.arrived_garbage_row_count)
+                tracer->recordGarbageRaised(player_devices[slot], player.arrived_garbage_row_count);
         }
     }
 
+    // the well updates touch only the state of their own player,
+    // so they can run on multiple threads
+    auto update_well = [this, &parent](size_t slot){
+        auto& player = players[slot];
+        if (player.status != PlayerStatus::PLAYING)
+            return;
+
+        auto& well = parent.player_areas[slot]->well();
+        well.updateGameplayOnly(input_events[slot]);
+        // all the arrived garbage is inserted at once
+        well.addGarbageRows(player.arrived_garbage_rows.data(), player.arrived_garbage_row_count);
+        player.arrived_garbage_row_count = 0;
+
+        parent.player_stats[slot].gametime += Timing::frame_duration;
+    };
+    if (workers)
+        workers->parallelFor(players.size(), update_well);
+    else {
+        for (size_t slot = 0; slot < players.size(); slot++)
+            update_well(slot);
+    }
+
+    // the rest uses textures and sounds, or affects the other players,
+    // so it's done on the main thread, in the order of the slots
+    for (size_t slot = 0; slot < players.size(); slot++) {
+        auto& parea = *parent.player_areas[slot];
+        if (players[slot].status == PlayerStatus::PLAYING)
+            parea.setGametime(parent.player_stats[slot].gametime);
+        parea.update();
+    }
+
+    // the observers may modify the wells, so they are only called
+    // after every well has finished its update
+    for (auto& parea : parent.player_areas)
+        parea->well().dispatchEvents();
+}
+
+void Gameplay::drawPassive(IngameState& parent, GraphicsContext& gcx) const
+{
+    for (const auto& parea : parent.player_areas)
+        parea->drawPassive(gcx);
+
+    for (const auto& player : players)
+        player.textpopups.draw();
+
     for (const auto& anim : attackanims)
         anim.draw();
 }
@@ -580,7 +722,7 @@ void Gameplay::drawPassive(IngameState& parent, GraphicsContext& gcx) const
 void Gameplay::drawActive(IngameState& parent, GraphicsContext& gcx) const
 {
    for (const auto& parea : parent.player_areas)
-        parea.second.drawActive(gcx);
+        parea->drawActive(gcx);
 }
 
 } // namespace States
@@ -1,22 +1,29 @@
 #pragma once
 
+#include "game/BattleTargeting.h"
+#include "game/GarbageTimeline.h"
 #include "game/Theme.h"
 #include "game/ScoreTable.h"
 #include "game/Transition.h"
+#include "game/components/Well.h"
 #include "game/components/animations/BattleAttack.h"
+#include "game/components/animations/TextPopupQueue.h"
 #include "game/states/substates/Ingame.h"
 
 #include <array>
-#include <list>
 #include <memory>
+#include <random>
 #include <stack>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 class Font;
 class Music;
 class SoundEffect;
-class TextPopup;
 class Texture;
+class WorkerPool;
+namespace Trace { class Recorder; }
 
 
 namespace SubStates {
@@ -30,7 +37,7 @@ public:
         std::unordered_map<DeviceID, size_t>&& team_setup = {});
     virtual ~Gameplay();
 
-    void updateAnimationsOnly(IngameState&, AppContext&) final;
+    void updateAnimationsOnly(IngameState&, Duration) final;
     void update(IngameState&, const std::vector<Event>&, AppContext&) final;
     void drawPassive(IngameState&, GraphicsContext&) const final;
     void drawActive(IngameState&, GraphicsContext&) const final;
@@ -53,21 +60,12 @@ private:
     std::shared_ptr<SoundEffect> sfx_ongameover;
     std::shared_ptr<SoundEffect> sfx_onfinish;
 
-    std::unordered_map<DeviceID, std::stack<unsigned short>> lineclears_required;
-    std::unordered_map<DeviceID, int> lineclears_left;
     bool usesDynamicLineAwards(IngameState&);
 
-    std::unordered_map<DeviceID, std::stack<Duration>> gravity_levels;
-    std::unordered_map<DeviceID, ScoreType> previous_lineclear_type;
-    std::unordered_map<DeviceID, unsigned short> back2back_length;
-
-    std::unordered_map<DeviceID, unsigned short> combo_length;
-    std::unordered_map<DeviceID, bool> prev_piece_cleared_line;
-    std::unordered_map<DeviceID, bool> current_piece_cleared_line;
-
-    std::unordered_map<DeviceID, unsigned short> pending_garbage_lines;
-    std::unordered_map<DeviceID, std::list<TextPopup>> textpopups;
-    std::list<BattleAttackAnim> attackanims;
+    /// The attack animations are reused, the oldest one if every slot is in use
+    std::array<BattleAttackAnim, 16> attackanims;
+    size_t next_attackanim;
+    std::string popup_text; ///< reused between popups, to avoid allocations
 
     Transition<unsigned> gameend_statistics_delay;
 
@@ -76,16 +74,58 @@ private:
         GAME_OVER,
         FINISHED,
     };
-    std::unordered_map<DeviceID, PlayerStatus> player_status;
-    std::unordered_map<DeviceID, size_t> player_team;
 
-    std::vector<DeviceID> playingPlayers();
-    void addNextPiece(IngameState&, DeviceID);
+    /// The game state of a player. The players are identified by their slot,
+    /// the index of their device in `player_devices`.
+    struct Player {
+        std::stack<unsigned short> lineclears_required;
+        int lineclears_left;
+
+        std::stack<Duration> gravity_levels;
+        ScoreType previous_lineclear_type;
+        unsigned short back2back_length;
+
+        unsigned short combo_length;
+        bool prev_piece_cleared_line;
+        bool current_piece_cleared_line;
+
+        GarbageTimeline incoming_garbage;
+        /// The rows of the arrived garbage, to be added in the next update
+        std::array<uint16_t, Well::matrix_rows> arrived_garbage_rows;
+        unsigned arrived_garbage_row_count;
+        /// A hold was requested while there was no active piece,
+        /// to be done when the next piece arrives
+        bool hold_pending;
+        TextPopupQueue textpopups;
+
+        PlayerStatus status;
+        size_t team;
+
+        Player();
+    };
+    std::vector<Player> players; ///< indexed by player slot
+    std::vector<std::vector<InputEvent>> input_events; ///< indexed by player slot, reused between frames
+    Trace::Recorder* const tracer; ///< can be nullptr
+    const ScoreRules& score_rules;
+    BattleTargeting targeting;
+    std::minstd_rand garbage_hole_rng;
+    const unsigned short garbage_delay;
+    uint32_t battle_frame; ///< the number of gameplay updates, for the garbage timing
+    std::unique_ptr<WorkerPool> workers; ///< nullptr if the wells are updated sequentially
+
+    void updateWells(IngameState&);
+
+    std::vector<size_t> playing_players; ///< reused between calls of `collectPlayingPlayers`
+
+    bool anyonePlaying() const;
+    void collectPlayingPlayers();
+    void addNextPiece(IngameState&, size_t slot);
+    void holdPiece(IngameState&, size_t slot);
     void registerObservers(IngameState&, AppContext&);
 
-    void increaseScoreMaybe(IngameState&, DeviceID, const WellEvent::lineclear_t&);
-    void sendGarbageMaybe(IngameState&, DeviceID, const WellEvent::lineclear_t&);
-    void increaseLevelMaybe(IngameState&, DeviceID, const WellEvent::lineclear_t&);
+    void increaseScoreMaybe(IngameState&, size_t slot, const WellEvent::lineclear_t&);
+    void sendGarbageMaybe(IngameState&, size_t slot, const WellEvent::lineclear_t&);
+    void increaseLevelMaybe(IngameState&, size_t slot, const WellEvent::lineclear_t&);
 };
 
 } // namespace States
@@ -0,0 +1,151 @@
+#include "Lobby.h"
+
+#include "Countdown.h"
+#include "FadeInOut.h"
+#include "Gameplay.h"
+#include "game/AppContext.h"
+#include "game/states/IngameState.h"
+#include "system/Color.h"
+#include "system/Font.h"
+#include "system/GraphicsContext.h"
+#include "system/Localize.h"
+#include "system/Paths.h"
+#include "system/util/MakeUnique.h"
+
+#include <assert.h>
+#include <algorithm>
+
+
+namespace SubStates {
+namespace Ingame {
+namespace States {
+
+Lobby::Lobby(AppContext& app)
+    : font_count(app.gcx().loadFont(Paths::data() + "fonts/PTS75F.ttf", 42))
+{
+    auto font_small = app.gcx().loadFont(Paths::data() + "fonts/PTS75F.ttf", 35);
+    tex_header = font_count->renderText(tr("BATTLE ROYALE"), app.theme().colors.mainmenu_highlight);
+    tex_join = font_small->renderText(tr("PRESS START TO JOIN!"), app.theme().colors.mainmenu_highlight);
+    tex_begin = font_small->renderText(tr("PRESS START TO JOIN, OR AGAIN TO BEGIN!"), app.theme().colors.mainmenu_highlight);
+    joined_devices.reserve(IngameState::max_player_count);
+    updateCountText();
+}
+
+void Lobby::updateCountText()
+{
+    tex_count = font_count->renderText(
+        std::to_string(joined_devices.size()) + " / " + std::to_string(IngameState::max_player_count),
+        0xFFFFFF_rgb);
+}
+
+void Lobby::onPlayerJoin(DeviceID device_id)
+{
+    assert(joined_devices.size() < IngameState::max_player_count);
+    joined_devices.push_back(device_id);
+    updateCountText();
+}
+
+void Lobby::onPlayerLeave(DeviceID device_id)
+{
+    const auto it = std::find(joined_devices.begin(), joined_devices.end(), device_id);
+    if (it == joined_devices.end())
+        return;
+
+    joined_devices.erase(it);
+    updateCountText();
+}
+
+void Lobby::update(IngameState& parent, const std::vector<Event>& events, AppContext& app)
+{
+    for (const auto& event : events) {
+        switch (event.type) {
+        case EventType::DEVICE:
+            if (event.device.type == DeviceEventType::DISCONNECTED)
+                onPlayerLeave(event.device.device_id);
+            break;
+        case EventType::INPUT:
+            if (event.input.down()) {
+                switch (event.input.type()) {
+                case InputType::MENU_OK: {
+                    const DeviceID device_id = event.input.srcDeviceID();
+                    const bool device_exists = std::find(joined_devices.begin(), joined_devices.end(), device_id)
+                                               != joined_devices.end();
+                    if (!device_exists) {
+                        if (joined_devices.size() < IngameState::max_player_count)
+                            onPlayerJoin(device_id);
+                    }
+                    else if (joined_devices.size() > 1) {
+                        // everyone plays for themselves
+                        assert(parent.device_order.empty());
+                        parent.device_order = joined_devices;
+
+                        parent.states.emplace_back(std::make_unique<FadeOut>([&parent, &app](){
+                            parent.states.emplace_back(std::make_unique<Gameplay>(app, parent));
+                            parent.states.emplace_back(std::make_unique<Countdown>(app));
+                            parent.states.emplace_back(std::make_unique<FadeIn>([&parent, &app](){
+                                parent.states.pop_back();
+                            }));
+                            parent.states.pop_front(); // pop lobby
+                            parent.states.pop_front(); // pop fadeout
+                        }));
+                        return;
+                    }
+                    break;
+                }
+                case InputType::MENU_CANCEL:
+                    if (joined_devices.empty()) {
+                        parent.states.emplace_back(std::make_unique<FadeOut>([&app](){
+                            app.states().pop();
+                        }));
+                        return;
+                    }
+                    onPlayerLeave(event.input.srcDeviceID());
+                    break;
+                default:
+                    break;
+                }
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void Lobby::drawPassive(IngameState& parent, GraphicsContext& gcx) const
+{
+    const auto screen_height = static_cast<int>(gcx.screenHeight() * parent.draw_inverse_scale);
+    const auto center_x = static_cast<int>(gcx.screenWidth() * parent.draw_inverse_scale / 2.f);
+
+    static constexpr int text_padding = 20;
+    int pos_y = text_padding;
+    tex_header->drawAt(center_x - tex_header->width() / 2, pos_y);
+    pos_y += tex_header->height() + text_padding;
+    tex_count->drawAt(center_x - tex_count->width() / 2, pos_y);
+    pos_y += tex_count->height() + text_padding;
+
+    const auto& tex_bottom = (joined_devices.size() > 1) ? tex_begin : tex_join;
+    const int bottom_y = screen_height - text_padding - tex_bottom->height();
+    tex_bottom->drawAt(center_x - tex_bottom->width() / 2, bottom_y);
+
+    // one tile for every possible player, in a square grid
+    static constexpr int grid_size = 8;
+    static_assert(grid_size * grid_size >= IngameState::max_player_count, "The lobby grid is too small");
+    static constexpr int tile_padding = 8;
+    const int tile_size = (bottom_y - text_padding - pos_y) / grid_size - tile_padding;
+    const int grid_width = grid_size * (tile_size + tile_padding) - tile_padding;
+
+    ::Rectangle tile_rect { 0, 0, tile_size, tile_size };
+    for (size_t idx = 0; idx < IngameState::max_player_count; idx++) {
+        tile_rect.x = center_x - grid_width / 2 + (idx % grid_size) * (tile_size + tile_padding);
+        tile_rect.y = pos_y + (idx / grid_size) * (tile_size + tile_padding);
+        if (idx < joined_devices.size())
+            gcx.drawFilledRect(tile_rect, 0xffffff60_rgba);
+        else
+            gcx.drawFilledRect(tile_rect, 0x00000040_rgba);
+    }
+}
+
+} // namespace States
+} // namespace Ingame
+} // namespace SubStates
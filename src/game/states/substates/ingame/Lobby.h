@@ -0,0 +1,40 @@
+#pragma once
+
+#include "game/states/substates/Ingame.h"
+
+#include <memory>
+#include <vector>
+
+class Font;
+class Texture;
+
+
+namespace SubStates {
+namespace Ingame {
+namespace States {
+
+/// The join screen of the battle royale mode. Every device can join
+/// by pressing start, and the game begins when a joined player presses it again.
+class Lobby : public State {
+public:
+    Lobby(AppContext&);
+    void update(IngameState&, const std::vector<Event>&, AppContext&) final;
+    void drawPassive(IngameState&, GraphicsContext&) const final;
+
+private:
+    std::vector<DeviceID> joined_devices; ///< in the order of joining
+
+    std::shared_ptr<Font> font_count;
+    std::unique_ptr<Texture> tex_header;
+    std::unique_ptr<Texture> tex_join;
+    std::unique_ptr<Texture> tex_begin;
+    std::unique_ptr<Texture> tex_count;
+
+    void onPlayerJoin(DeviceID);
+    void onPlayerLeave(DeviceID);
+    void updateCountText();
+};
+
+} // namespace States
+} // namespace Ingame
+} // namespace SubStates
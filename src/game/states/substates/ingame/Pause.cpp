@@ -20,6 +20,7 @@ namespace States {
 
 Pause::Pause(AppContext& app)
     : current_menuitem(0)
+    , cursor_fade(std::chrono::milliseconds(150), [](double t){ return t * 0xFF; })
 {
     app.audio().pauseAll();
 
@@ -40,6 +41,11 @@ Pause::Pause(AppContext& app)
     }
 }
 
+void Pause::updateAnimationsOnly(IngameState&, Duration elapsed)
+{
+    cursor_fade.update(elapsed);
+}
+
 void Pause::update(IngameState& parent, const std::vector<Event>& events, AppContext& app)
 {
     for (const auto& event : events) {
@@ -77,12 +83,16 @@ void Pause::update(IngameState& parent, const std::vector<Event>& events, AppCon
                     }
                     break;
                 case InputType::MENU_UP:
-                    if (current_menuitem > 0)
+                    if (current_menuitem > 0) {
                         current_menuitem--;
+                        cursor_fade.restart();
+                    }
                     break;
                 case InputType::MENU_DOWN:
-                    if (current_menuitem + 1 < tex_menuitems.size())
+                    if (current_menuitem + 1 < tex_menuitems.size()) {
                         current_menuitem++;
+                        cursor_fade.restart();
+                    }
                     break;
                 default:
                     break;
@@ -91,20 +101,35 @@ void Pause::update(IngameState& parent, const std::vector<Event>& events, AppCon
     }
 }
 
-void Pause::drawActive(IngameState& parent, GraphicsContext&) const
+void Pause::drawActive(IngameState& parent, GraphicsContext& gcx) const
+{
+    // the mini wells are too small for the menu, draw it only once
+    if (parent.player_areas.front()->isMini()) {
+        drawMenu(gcx.screenWidth() * parent.draw_inverse_scale / 2,
+                 gcx.screenHeight() * parent.draw_inverse_scale / 2);
+        return;
+    }
+
+    for (const auto& ui_pa : parent.player_areas)
+        drawMenu(ui_pa->wellCenterX(), ui_pa->wellCenterY());
+}
+
+void Pause::drawMenu(int center_x, int center_y) const
 {
-    for (const auto& ui_pa : parent.player_areas) {
-        const int center_x = ui_pa.second.wellCenterX();
-        const int center_y = ui_pa.second.wellCenterY();
-        tex_pause->drawAt(
-            center_x - tex_pause->width() / 2,
-            center_y - tex_pause->height() / 2);
-
-        for (size_t i = 0; i < tex_menuitems.size(); i++) {
-            const auto& tex = tex_menuitems.at(i).at(i == current_menuitem ? 1 : 0);
-            tex->drawAt(
-                center_x - tex->width() / 2,
-                center_y + 150 + i * tex->height());
+    tex_pause->drawAt(
+        center_x - tex_pause->width() / 2,
+        center_y - tex_pause->height() / 2);
+
+    for (size_t i = 0; i < tex_menuitems.size(); i++) {
+        const auto& tex = tex_menuitems.at(i).at(0);
+        const int x = center_x - tex->width() / 2;
+        const int y = center_y + 150 + i * tex->height();
+        tex->drawAt(x, y);
+
+        if (i == current_menuitem) {
+            const auto& tex_highlight = tex_menuitems.at(i).at(1);
+            tex_highlight->setAlpha(cursor_fade.value());
+            tex_highlight->drawAt(x, y);
         }
     }
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "game/Transition.h"
 #include "game/states/substates/Ingame.h"
 
 #include <array>
@@ -15,13 +16,18 @@ namespace States {
 class Pause : public State {
 public:
     Pause(AppContext&);
+    void updateAnimationsOnly(IngameState&, Duration) final;
     void update(IngameState&, const std::vector<Event>&, AppContext&) final;
     void drawActive(IngameState&, GraphicsContext&) const final;
+    bool needsRedraw(const IngameState&) const final { return cursor_fade.running(); }
 
 private:
     std::unique_ptr<Texture> tex_pause;
     std::vector<std::array<std::unique_ptr<Texture>, 2>> tex_menuitems;
     size_t current_menuitem;
+    Transition<uint8_t> cursor_fade; ///< the highlight of the selected item fades in
+
+    void drawMenu(int center_x, int center_y) const;
 };
 
 } // namespace States
@@ -17,6 +17,7 @@
 
 #include <assert.h>
 #include <algorithm>
+#include <set>
 
 
 namespace SubStates {
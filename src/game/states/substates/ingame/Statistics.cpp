@@ -48,10 +48,11 @@ Statistics::Statistics(IngameState& parent, AppContext& app)
     labels.emplace_back(font_highlight->renderText(tr("Level"), color_highlight));
     labels.emplace_back(font_highlight->renderText(tr("Final Score"), color_highlight));
 
-    for (const DeviceID device_id : parent.device_order) {
-        auto& stats = parent.player_stats.at(device_id);
+    scores.resize(parent.player_stats.size());
+    for (size_t slot = 0; slot < parent.player_stats.size(); slot++) {
+        auto& stats = parent.player_stats[slot];
         auto& event_cnt = stats.event_count;
-        auto& texs = scores[device_id];
+        auto& texs = scores[slot];
 
         texs.emplace_back(font->renderText(std::to_string(stats.total_cleared_lines), color));
         texs.emplace_back(font->renderText(std::to_string(event_cnt[ScoreType::CLEAR_SINGLE]), color));
@@ -91,8 +92,16 @@ void Statistics::update(IngameState& parent, const std::vector<Event>& events, A
 
 void Statistics::drawItems(IngameState& parent) const
 {
-    for (const DeviceID device_id : parent.device_order) {
-        const auto& ui_pa = parent.player_areas.at(device_id);
+    for (size_t slot = 0; slot < parent.player_areas.size(); slot++) {
+        const auto& ui_pa = *parent.player_areas[slot];
+
+        // the mini wells have space only for the final score
+        if (ui_pa.isMini()) {
+            const auto& score = scores[slot].back();
+            score->drawAt(ui_pa.wellCenterX() - score->width() / 2,
+                          ui_pa.wellCenterY() - score->height() / 2);
+            continue;
+        }
 
         const int pos_x = ui_pa.wellBox().x + 5;
         const int pos_x_right = ui_pa.wellBox().x + ui_pa.wellBox().w - 5;
@@ -102,7 +111,7 @@ void Statistics::drawItems(IngameState& parent) const
         tex_title->drawAt(pos_x, pos_y);
         pos_y += tex_title->height() * 1.25;
 
-        const auto& values = scores.at(device_id);
+        const auto& values = scores[slot];
         assert(displayed_item_count.value() <= labels.size());
         assert(displayed_item_count.value() <= values.size());
 
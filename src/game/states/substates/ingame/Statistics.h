@@ -5,7 +5,7 @@
 #include "system/Color.h"
 
 #include <memory>
-#include <unordered_map>
+#include <vector>
 
 class Texture;
 
@@ -19,11 +19,12 @@ public:
     Statistics(IngameState&, AppContext&);
     void update(IngameState&, const std::vector<Event>&, AppContext&) final;
     void drawPassive(IngameState&, GraphicsContext&) const final;
+    bool needsRedraw(const IngameState&) const final { return displayed_item_count.running(); }
 
 private:
     std::unique_ptr<Texture> tex_title;
     std::vector<std::unique_ptr<Texture>> labels;
-    std::unordered_map<DeviceID, std::vector<std::unique_ptr<Texture>>> scores;
+    std::vector<std::vector<std::unique_ptr<Texture>>> scores; ///< indexed by player slot
 
     Transition<uint8_t> displayed_item_count;
 
@@ -5,6 +5,7 @@
 #include "game/Theme.h"
 #include "game/components/MinoStorage.h"
 #include "game/components/PieceFactory.h"
+#include "game/components/PiecePreviews.h"
 #include "game/components/rotations/SRS.h"
 #include "game/states/MainMenuState.h"
 #include "game/states/IngameState.h"
@@ -60,9 +61,8 @@ void Base::reloadTheme(MainMenuState& parent, AppContext& app)
 
 void Base::reloadGameAssets(AppContext& app)
 {
-    MinoStorage::loadMinos(app);
-    MinoStorage::loadGhosts(app);
-    MinoStorage::loadMatrixCell(app.gcx(), app.theme().get_texture("matrix.png"));
+    MinoStorage::loadTextures(app);
+    PiecePreviews::render(app.gcx());
 }
 
 void Base::reloadUI(MainMenuState& parent, AppContext& app)
@@ -120,6 +120,8 @@ void Base::reloadUI(MainMenuState& parent, AppContext& app)
 
         multiplayer_buttons.buttons.emplace_back(app, tr("BATTLE"),
             [this, &app](){ startGame(app, GameMode::MP_BATTLE); });
+        multiplayer_buttons.buttons.emplace_back(app, tr("BATTLE ROYALE"),
+            [this, &app](){ startGame(app, GameMode::MP_BATTLE_ROYALE); });
         multiplayer_buttons.buttons.emplace_back(app, tr("MARATHON"),
             [this, &app](){ startGame(app, GameMode::MP_MARATHON); });
         multiplayer_buttons.buttons.emplace_back(app, tr("MARATHON SIMPLE"),
@@ -129,6 +131,10 @@ void Base::reloadUI(MainMenuState& parent, AppContext& app)
             tr("Battle with you friends: clear\n"
                "multiple lines, and throw them\n"
                "to the other players!"), desc_color, TextAlign::RIGHT));
+        multiplayer_buttons.descriptions.emplace_back(desc_font->renderText(
+            tr("Battle with up to 64 players,\n"
+               "everyone for themselves.\n"
+               "The last one standing wins!"), desc_color, TextAlign::RIGHT));
         multiplayer_buttons.descriptions.emplace_back(desc_font->renderText(
             tr("Clear 15 levels with increasing\n"
                "difficulty - use advanced moves\n"
@@ -249,12 +255,13 @@ void Base::onFadeoutComplete(AppContext& app, std::unique_ptr<GameState>&& newst
     app.states().emplace(std::move(newstate));
 }
 
-void Base::updateAnimationsOnly(MainMenuState&, AppContext&)
+void Base::updateAnimationsOnly(MainMenuState& parent, Duration elapsed)
 {
-    column_slide_anim.update(Timing::frame_duration);
-
-    for (auto& rain : rains)
-        rain.update();
+    // stop the rain if nobody is around, so the menu doesn't have to be redrawn
+    if (!parent.idle()) {
+        for (auto& rain : rains)
+            rain.update(elapsed);
+    }
 }
 
 Base::ButtonColumn::ButtonColumn()
@@ -282,9 +289,10 @@ void Base::ButtonColumn::activate()
     buttons.at(selected_index).onPress();
 }
 
-void Base::update(MainMenuState& parent, const std::vector<Event>& events, AppContext& app)
+void Base::update(MainMenuState&, const std::vector<Event>& events, AppContext& app)
 {
-    updateAnimationsOnly(parent, app);
+    // the buttons don't accept input while sliding, so this is updated with the logic
+    column_slide_anim.update(Timing::frame_duration);
 
     if (state_transition_alpha) {
         state_transition_alpha->update(Timing::frame_duration);
@@ -347,6 +355,11 @@ void Base::update(MainMenuState& parent, const std::vector<Event>& events, AppCo
     }
 }
 
+bool Base::needsRedraw(const MainMenuState& parent) const
+{
+    return !parent.idle() || column_slide_anim.running() || state_transition_alpha;
+}
+
 void Base::draw(MainMenuState&, GraphicsContext& gcx) const
 {
     tex_background->drawScaled(screen_rect);
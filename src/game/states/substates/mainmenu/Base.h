@@ -24,10 +24,11 @@ class Base : public State {
 public:
     Base(MainMenuState&, AppContext&);
     ~Base();
-    void updateAnimationsOnly(MainMenuState&, AppContext&) final;
+    void updateAnimationsOnly(MainMenuState&, Duration) final;
     void update(MainMenuState&, const std::vector<Event>&, AppContext&) final;
     void updatePositions(GraphicsContext&) final;
     void draw(MainMenuState&, GraphicsContext&) const final;
+    bool needsRedraw(const MainMenuState&) const final;
 
     void reloadTheme(MainMenuState&, AppContext&);
 
@@ -72,6 +72,30 @@ Options::Options(MainMenuState& parent, AppContext& app)
             }));
         system_options.back()->setMarginBottom(40);
 
+        system_options.emplace_back(std::make_shared<ToggleButton>(
+            app, app.sysconfig().parallel_wells, tr("Parallel well updates"),
+            tr("Update the wells of the players on multiple threads. Useful for games with lots of players."),
+            [&app](bool val){
+                app.sysconfig().parallel_wells = val;
+            }));
+        system_options.emplace_back(std::make_shared<ValueChooser>(app,
+            std::vector<std::string>({tr("VSync"), tr("Low latency"), tr("Timer")}),
+            app.sysconfig().frame_pacing == FramePacing::VSYNC ?
+                0 : (app.sysconfig().frame_pacing == FramePacing::VSYNC_LATE_LATCH ? 1 : 2),
+            tr("Frame pacing"),
+            std::string(tr("VSync: The frames are synchronized to the display.\n")) +
+                tr("Low latency: Like VSync, but the input is read right before the next frame is due.\n") +
+                tr("Timer: No synchronization, the frames are started by a precise timer."),
+            [&app](const std::string& val){
+                static const std::unordered_map<std::string, FramePacing> map = {
+                    {tr("VSync"), FramePacing::VSYNC},
+                    {tr("Low latency"), FramePacing::VSYNC_LATE_LATCH},
+                    {tr("Timer"), FramePacing::TIMER},
+                };
+                app.sysconfig().frame_pacing = map.at(val);
+            }));
+        system_options.back()->setMarginBottom(40);
+
         auto detected_themes = detectedThemes();
         const size_t current_theme_idx = std::distance(detected_themes.begin(),
             std::find(detected_themes.begin(), detected_themes.end(), app.sysconfig().theme_dir_name));
@@ -106,6 +130,97 @@ Options::Options(MainMenuState& parent, AppContext& app)
                 app.wellconfig().rotation_style = map.at(val);
             }));
 
+        static const std::vector<std::pair<std::string, RandomizerType>> randomizers = {
+            {tr("7-bag"), RandomizerType::BAG7},
+            {tr("14-bag"), RandomizerType::BAG14},
+            {tr("7+1 bag"), RandomizerType::BAG7_PLUS1},
+            {tr("History"), RandomizerType::TGM_HISTORY},
+            {tr("Random"), RandomizerType::PURE_RANDOM},
+        };
+        std::vector<std::string> randomizer_names;
+        size_t current_randomizer_idx = 0;
+        for (size_t i = 0; i < randomizers.size(); i++) {
+            randomizer_names.push_back(randomizers[i].first);
+            if (randomizers[i].second == app.wellconfig().randomizer)
+                current_randomizer_idx = i;
+        }
+        tuning_options.emplace_back(std::make_shared<ValueChooser>(app,
+            std::move(randomizer_names), current_randomizer_idx,
+            tr("Randomizer"),
+            std::string(tr("7-bag, 14-bag: Every piece comes once (or twice) in every 7 (or 14) pieces.\n")) +
+                tr("7+1 bag: A 7-bag plus a random piece. History: Recent pieces rarely repeat.\n") +
+                tr("Random: Every piece is completely random."),
+            [&app](const std::string& val){
+                for (const auto& item : randomizers) {
+                    if (item.first == val)
+                        app.wellconfig().randomizer = item.second;
+                }
+            }));
+
+        static const std::vector<std::pair<std::string, TargetingType>> targetings = {
+            {tr("Random"), TargetingType::RANDOM},
+            {tr("Attackers"), TargetingType::ATTACKERS},
+            {tr("KO focus"), TargetingType::KO_FOCUSED},
+        };
+        std::vector<std::string> targeting_names;
+        size_t current_targeting_idx = 0;
+        for (size_t i = 0; i < targetings.size(); i++) {
+            targeting_names.push_back(targetings[i].first);
+            if (targetings[i].second == app.wellconfig().battle_targeting)
+                current_targeting_idx = i;
+        }
+        tuning_options.emplace_back(std::make_shared<ValueChooser>(app,
+            std::move(targeting_names), current_targeting_idx,
+            tr("Battle targeting"),
+            std::string(tr("Random: Garbage is sent to a random opponent.\n")) +
+                tr("Attackers: Garbage is sent back to the last attacker, if possible.\n") +
+                tr("KO focus: Everyone attacks the same opponent, until they are knocked out."),
+            [&app](const std::string& val){
+                for (const auto& item : targetings) {
+                    if (item.first == val)
+                        app.wellconfig().battle_targeting = item.second;
+                }
+            }));
+
+        static const std::vector<std::pair<std::string, ScoreRuleSet>> score_rule_sets = {
+            {tr("Guideline"), ScoreRuleSet::GUIDELINE},
+            {tr("Classic"), ScoreRuleSet::CLASSIC},
+            {tr("Custom"), ScoreRuleSet::CUSTOM},
+        };
+        std::vector<std::string> score_rule_names;
+        size_t current_score_rules_idx = 0;
+        for (size_t i = 0; i < score_rule_sets.size(); i++) {
+            score_rule_names.push_back(score_rule_sets[i].first);
+            if (score_rule_sets[i].second == app.wellconfig().score_rules)
+                current_score_rules_idx = i;
+        }
+        tuning_options.emplace_back(std::make_shared<ValueChooser>(app,
+            std::move(score_rule_names), current_score_rules_idx,
+            tr("Scoring rules"),
+            std::string(tr("Guideline: T-Spins, back-to-back clears and combos give extra points and attack.\n")) +
+                tr("Classic: Only the number of cleared lines matters. Always used in the Simple modes.\n") +
+                tr("Custom: The values of the 'scoring' block of the config file."),
+            [&app](const std::string& val){
+                for (const auto& item : score_rule_sets) {
+                    if (item.first == val)
+                        app.wellconfig().score_rules = item.second;
+                }
+            }));
+
+        int garbage_frames = -1;
+        std::vector<std::string> garbage_delay_values(121);
+        std::generate(garbage_delay_values.begin(), garbage_delay_values.end(),
+            [&garbage_frames]{ return std::to_string(++garbage_frames) + "/60 s"; });
+        tuning_options.emplace_back(std::make_shared<ValueChooser>(app,
+            std::move(garbage_delay_values),
+            std::min<size_t>(120, app.wellconfig().garbage_delay),
+            tr("Garbage delay"),
+            tr("The time it takes for the garbage sent in battles to arrive. It can be cancelled until then."),
+            [&app](const std::string& val){
+                // this must not throw error
+                app.wellconfig().garbage_delay = std::stoul(val.substr(0, val.find("/")));
+            }));
+
         std::vector<std::string> das_values(20);
         int k = 0;
         std::generate(das_values.begin(), das_values.end(), [&k]{ return std::to_string(++k) + "/60 s"; });
@@ -399,8 +514,6 @@ void Options::updatePositions(GraphicsContext& gcx)
 
 void Options::update(MainMenuState& parent, const std::vector<Event>& events, AppContext& app)
 {
-    parent.states.front()->updateAnimationsOnly(parent, app);
-
     if (current_subitem && current_subitem->isLocked()) {
         for (const auto& event : events) {
             switch (event.type) {
@@ -436,6 +549,11 @@ void Options::update(MainMenuState& parent, const std::vector<Event>& events, Ap
     }
 }
 
+bool Options::needsRedraw(const MainMenuState& parent) const
+{
+    return parent.states.front()->needsRedraw(parent);
+}
+
 void Options::draw(MainMenuState& parent, GraphicsContext& gcx) const
 {
     parent.states.front()->draw(parent, gcx);
@@ -21,6 +21,7 @@ public:
     ~Options();
     void update(MainMenuState&, const std::vector<Event>&, AppContext&) final;
     void draw(MainMenuState&, GraphicsContext&) const final;
+    bool needsRedraw(const MainMenuState&) const final;
 
 private:
     ::Rectangle screen_rect;
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdint.h>
+
+
+namespace Trace {
+
+/// The trace file starts with a `FileHeader`, followed by `Record`s until
+/// the end of the file. The values are stored in native byte order.
+struct FileHeader {
+    static constexpr uint16_t format_version = 1;
+
+    char magic[4]; ///< "OBTR"
+    uint16_t version;
+    uint16_t record_size;
+    uint64_t start_time_ms; ///< wall clock time of the recording start, in Unix time
+};
+
+enum class RecordKind : uint8_t {
+    UPDATE, ///< a game logic update started
+    RENDER, ///< a frame was presented, `value` is the number of heap allocations in the frame (debug builds only)
+    INPUT, ///< `type` is an InputType, `value` is 1 for key press
+    WELL_EVENT, ///< `type` is a WellEvent::Type, `value` is the line clear or harddrop count
+    GARBAGE_QUEUED, ///< `value` lines were sent to the player
+    GARBAGE_RAISED, ///< `value` lines were added to the player's well
+};
+
+struct Record {
+    uint64_t time_ns; ///< time since the start of the recording
+    uint32_t frame; ///< the number of game logic updates before this record
+    RecordKind kind;
+    int8_t device; ///< the player's device, or -1
+    uint8_t type;
+    uint8_t value;
+};
+
+static_assert(sizeof(FileHeader) == 16, "Unexpected trace header padding");
+static_assert(sizeof(Record) == 16, "Unexpected trace record padding");
+
+} // namespace Trace
@@ -0,0 +1,259 @@
+#include "TraceRecorder.h"
+
+#include "system/Log.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <assert.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+
+namespace Trace {
+
+constexpr uint16_t FileHeader::format_version;
+
+#ifndef _WIN32
+/// Writes into the output file through a memory mapped window,
+/// which is moved forward (and the file extended) when it gets full.
+struct Recorder::Output {
+    static constexpr size_t window_size = 4 << 20; // a multiple of the page size
+
+    int fd;
+    uint8_t* window;
+    size_t window_offset; ///< the position of the window in the file
+    size_t window_used;
+
+    explicit Output(const std::string& path)
+        : fd(open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644))
+        , window(nullptr)
+        , window_offset(0)
+        , window_used(0)
+    {}
+
+    bool isOpen() const { return fd >= 0; }
+
+    bool mapWindow() {
+        if (ftruncate(fd, window_offset + window_size) != 0)
+            return false;
+
+        void* addr = mmap(nullptr, window_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, window_offset);
+        if (addr == MAP_FAILED)
+            return false;
+
+        window = static_cast<uint8_t*>(addr);
+        window_used = 0;
+        return true;
+    }
+
+    bool write(const void* data, size_t length) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        while (length) {
+            if (!window || window_used == window_size) {
+                if (window) {
+                    munmap(window, window_size);
+                    window = nullptr;
+                    window_offset += window_size;
+                }
+                if (!mapWindow())
+                    return false;
+            }
+
+            const size_t count = std::min(length, window_size - window_used);
+            std::memcpy(window + window_used, bytes, count);
+            window_used += count;
+            bytes += count;
+            length -= count;
+        }
+        return true;
+    }
+
+    bool close() {
+        bool success = true;
+        if (window) {
+            success = munmap(window, window_size) == 0;
+            window = nullptr;
+        }
+        // cut the unused part of the last window
+        success = ftruncate(fd, window_offset + window_used) == 0 && success;
+        success = ::close(fd) == 0 && success;
+        fd = -1;
+        return success;
+    }
+};
+#else
+/// Memory mapping is not implemented on this platform, use regular file writes instead
+struct Recorder::Output {
+    FILE* file;
+
+    explicit Output(const std::string& path)
+        : file(std::fopen(path.c_str(), "wb"))
+    {}
+
+    bool isOpen() const { return file != nullptr; }
+
+    bool write(const void* data, size_t length) {
+        return std::fwrite(data, 1, length, file) == length;
+    }
+
+    bool close() {
+        const bool success = std::fclose(file) == 0;
+        file = nullptr;
+        return success;
+    }
+};
+#endif
+
+namespace {
+const std::string LOG_TAG = "trace";
+} // namespace
+
+
+Recorder::Recorder(const std::string& path, size_t capacity)
+    : start_time(std::chrono::steady_clock::now())
+    , frame(0)
+    , ring(capacity)
+    , ring_mask(capacity - 1)
+    , write_pos(0)
+    , read_pos(0)
+    , dropped_records(0)
+    , closing(false)
+    , output(new Output(path))
+    , write_failed(false)
+{
+    assert(capacity > 0 && (capacity & (capacity - 1)) == 0);
+    if (!output->isOpen())
+        throw std::runtime_error("Could not open '" + path + "' for writing");
+
+    FileHeader header;
+    std::memcpy(header.magic, "OBTR", 4);
+    header.version = FileHeader::format_version;
+    header.record_size = sizeof(Record);
+    header.start_time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    write_failed = !output->write(&header, sizeof(header));
+
+    thread = std::thread(&Recorder::writerLoop, this);
+}
+
+Recorder::~Recorder()
+{
+    finish();
+}
+
+void Recorder::markUpdate()
+{
+    push(RecordKind::UPDATE, -1, 0, 0);
+    frame++;
+}
+
+void Recorder::markRender(uint64_t allocations)
+{
+    push(RecordKind::RENDER, -1, 0, static_cast<uint8_t>(std::min<uint64_t>(allocations, 0xFF)));
+}
+
+void Recorder::recordInput(const InputEvent& event)
+{
+    push(RecordKind::INPUT, event.srcDeviceID(), static_cast<uint8_t>(event.type()), event.down());
+}
+
+void Recorder::recordWellEvent(DeviceID device_id, const WellEvent& event)
+{
+    uint8_t value = 0;
+    switch (event.type) {
+        case WellEvent::Type::HARDDROPPED:
+            value = event.harddrop.count;
+            break;
+        case WellEvent::Type::LINE_CLEAR_ANIMATION_START:
+        case WellEvent::Type::LINE_CLEAR:
+            value = event.lineclear.count;
+            break;
+        default:
+            break;
+    }
+    push(RecordKind::WELL_EVENT, device_id, static_cast<uint8_t>(event.type), value);
+}
+
+void Recorder::recordGarbageQueued(DeviceID device_id, unsigned lines)
+{
+    push(RecordKind::GARBAGE_QUEUED, device_id, 0, std::min(lines, 0xFFu));
+}
+
+void Recorder::recordGarbageRaised(DeviceID device_id, unsigned lines)
+{
+    push(RecordKind::GARBAGE_RAISED, device_id, 0, std::min(lines, 0xFFu));
+}
+
+void Recorder::push(RecordKind kind, DeviceID device_id, uint8_t type, uint8_t value)
+{
+    const uint64_t pos = write_pos.load(std::memory_order_relaxed);
+    if (pos - read_pos.load(std::memory_order_acquire) > ring_mask) {
+        dropped_records.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Record& record = ring[pos & ring_mask];
+    record.time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start_time).count();
+    record.frame = frame;
+    record.kind = kind;
+    record.device = device_id;
+    record.type = type;
+    record.value = value;
+    write_pos.store(pos + 1, std::memory_order_release);
+}
+
+void Recorder::writerLoop()
+{
+    while (true) {
+        // `closing` has to be read before the position,
+        // so the records pushed before closing are not lost
+        const bool last_round = closing.load(std::memory_order_acquire);
+        const uint64_t begin = read_pos.load(std::memory_order_relaxed);
+        const uint64_t end = write_pos.load(std::memory_order_acquire);
+
+        if (begin == end) {
+            if (last_round)
+                break;
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            continue;
+        }
+
+        // copy the records in at most two continuous parts
+        uint64_t pos = begin;
+        while (pos != end && !write_failed) {
+            const size_t idx = pos & ring_mask;
+            const size_t count = std::min<uint64_t>(end - pos, ring.size() - idx);
+            write_failed = !output->write(&ring[idx], count * sizeof(Record));
+            pos += count;
+        }
+        read_pos.store(end, std::memory_order_release);
+    }
+}
+
+bool Recorder::finish()
+{
+    if (!thread.joinable())
+        return !write_failed;
+
+    closing.store(true, std::memory_order_release);
+    thread.join();
+
+    if (!output->close())
+        write_failed = true;
+
+    if (write_failed)
+        Log::error(LOG_TAG) << "Could not write the trace file\n";
+    if (dropped_records)
+        Log::warning(LOG_TAG) << dropped_records << " trace records were dropped\n";
+    return !write_failed;
+}
+
+} // namespace Trace
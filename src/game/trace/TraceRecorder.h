@@ -0,0 +1,67 @@
+#pragma once
+
+#include "TraceFormat.h"
+#include "game/WellEvent.h"
+#include "system/Event.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace Trace {
+
+/// Records the inputs, the well events and frame timing markers of a game
+/// session into a binary trace file, for offline analysis.
+///
+/// The records are written into a lock-free ring buffer, from which a
+/// background thread copies them into the memory mapped output file.
+/// The record functions must be called from one thread only (the main loop).
+/// If the writer thread falls behind, new records are dropped and counted.
+class Recorder {
+public:
+    /// Create the output file and start the writer thread. Throws `std::runtime_error`
+    /// if the file can not be created. `capacity` is the size of the ring buffer,
+    /// in records, and has to be a power of two.
+    Recorder(const std::string& path, size_t capacity = 1 << 16);
+    ~Recorder();
+
+    void markUpdate();
+    /// Mark the end of a frame; `allocations` is the number of heap allocations
+    /// since the previous frame, and is clamped to 255
+    void markRender(uint64_t allocations = 0);
+    void recordInput(const InputEvent&);
+    void recordWellEvent(DeviceID, const WellEvent&);
+    void recordGarbageQueued(DeviceID, unsigned lines);
+    void recordGarbageRaised(DeviceID, unsigned lines);
+
+    /// Write out the remaining records and close the file.
+    /// Returns false if there was a write error.
+    bool finish();
+
+    uint64_t droppedRecords() const { return dropped_records; }
+
+private:
+    const std::chrono::steady_clock::time_point start_time;
+    uint32_t frame;
+
+    std::vector<Record> ring;
+    const uint64_t ring_mask;
+    std::atomic<uint64_t> write_pos;
+    std::atomic<uint64_t> read_pos;
+    std::atomic<uint64_t> dropped_records;
+    std::atomic<bool> closing;
+
+    struct Output;
+    std::unique_ptr<Output> output;
+    bool write_failed;
+    std::thread thread;
+
+    void push(RecordKind, DeviceID, uint8_t type, uint8_t value);
+    void writerLoop();
+};
+
+} // namespace Trace
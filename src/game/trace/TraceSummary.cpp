@@ -0,0 +1,177 @@
+#include "TraceSummary.h"
+
+#include "TraceFormat.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <stdexcept>
+#include <assert.h>
+
+
+namespace Trace {
+
+constexpr unsigned Summary::input_type_count;
+
+namespace {
+const std::array<const char*, Summary::input_type_count> input_names = {{
+    "pause", "hold", "hard drop", "soft drop", "move left", "move right", "rotate left", "rotate right",
+    "menu up", "menu down", "menu left", "menu right", "menu ok", "menu cancel",
+}};
+
+const std::array<const char*, WellEvent::type_count> well_event_names = {{
+    "piece locked", "piece rotated", "piece moved", "next requested", "hold requested",
+    "line clear animation", "line clear", "t-spin", "mini t-spin", "soft drop", "hard drop", "game over",
+}};
+
+double toSeconds(uint64_t ns)
+{
+    return ns / 1e9;
+}
+
+double toMillis(uint64_t ns)
+{
+    return ns / 1e6;
+}
+
+LatencyStats calculateStats(std::vector<uint64_t>& samples)
+{
+    LatencyStats stats = {};
+    if (samples.empty())
+        return stats;
+
+    std::sort(samples.begin(), samples.end());
+    uint64_t sum = 0;
+    for (const uint64_t sample : samples)
+        sum += sample;
+
+    stats.count = samples.size();
+    stats.min_ns = samples.front();
+    stats.max_ns = samples.back();
+    stats.mean_ns = sum / samples.size();
+    stats.p95_ns = samples[(samples.size() - 1) * 95 / 100];
+    return stats;
+}
+} // namespace
+
+
+Summary Summary::fromFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("Could not open '" + path + "'");
+
+    FileHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || std::memcmp(header.magic, "OBTR", 4) != 0
+        || header.record_size != sizeof(Record))
+        throw std::runtime_error("'" + path + "' is not a valid trace file");
+    if (header.version != FileHeader::format_version)
+        throw std::runtime_error("'" + path + "' has an unsupported trace version");
+
+    Summary summary = {};
+    std::vector<uint64_t> lock_latencies;
+    // the time of the last key press since the last lock, per device;
+    // -1 is the merged input of single player games, so it tracks every device
+    std::map<DeviceID, uint64_t> last_input;
+    uint64_t last_render = 0;
+
+    Record record;
+    while (file.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+        summary.record_count++;
+        summary.duration_ns = std::max(summary.duration_ns, record.time_ns);
+
+        switch (record.kind) {
+            case RecordKind::UPDATE:
+                summary.updates++;
+                break;
+            case RecordKind::RENDER:
+                if (summary.renders)
+                    summary.render_interval_max_ns = std::max(summary.render_interval_max_ns, record.time_ns - last_render);
+                summary.renders++;
+                last_render = record.time_ns;
+                if (record.value) {
+                    summary.frames_with_allocations++;
+                    summary.max_frame_allocations = std::max<unsigned>(summary.max_frame_allocations, record.value);
+                }
+                break;
+            case RecordKind::INPUT:
+                if (record.type < input_type_count && record.value) {
+                    summary.key_presses[record.type]++;
+                    last_input[record.device] = record.time_ns;
+                    last_input[-1] = record.time_ns;
+                }
+                break;
+            case RecordKind::WELL_EVENT:
+                if (record.type < WellEvent::type_count) {
+                    summary.well_events[record.type]++;
+
+                    const auto input = last_input.find(record.device);
+                    if (record.type == static_cast<uint8_t>(WellEvent::Type::PIECE_LOCKED) && input != last_input.end()) {
+                        lock_latencies.push_back(record.time_ns - input->second);
+                        last_input.erase(input);
+                    }
+                }
+                break;
+            case RecordKind::GARBAGE_QUEUED:
+            case RecordKind::GARBAGE_RAISED:
+                summary.garbage.push_back({record.time_ns, record.device,
+                                           record.kind == RecordKind::GARBAGE_RAISED, record.value});
+                break;
+        }
+    }
+
+    summary.input_to_lock = calculateStats(lock_latencies);
+    return summary;
+}
+
+void Summary::print(std::ostream& out) const
+{
+    const double seconds = std::max(toSeconds(duration_ns), 0.001);
+
+    out << std::fixed << std::setprecision(2);
+    out << record_count << " records in " << seconds << " seconds\n";
+    out << "  updates: " << updates << " (" << updates / seconds << "/s)\n";
+    out << "  frames:  " << renders << " (" << renders / seconds << "/s), "
+        << "longest frame time " << toMillis(render_interval_max_ns) << " ms\n";
+    if (frames_with_allocations)
+        out << "  frames with heap allocations: " << frames_with_allocations
+            << ", at most " << max_frame_allocations << " per frame\n";
+
+    out << "Key presses:\n";
+    for (unsigned i = 0; i < input_type_count; i++) {
+        if (key_presses[i])
+            out << "  " << std::setw(22) << std::left << input_names[i] << std::right
+                << std::setw(8) << key_presses[i] << " (" << key_presses[i] / seconds << "/s)\n";
+    }
+
+    out << "Well events:\n";
+    for (unsigned i = 0; i < WellEvent::type_count; i++) {
+        if (well_events[i])
+            out << "  " << std::setw(22) << std::left << well_event_names[i] << std::right
+                << std::setw(8) << well_events[i] << " (" << well_events[i] / seconds << "/s)\n";
+    }
+
+    out << "Input to lock latency:\n";
+    if (input_to_lock.count) {
+        out << "  " << input_to_lock.count << " locks, min " << toMillis(input_to_lock.min_ns)
+            << " ms, mean " << toMillis(input_to_lock.mean_ns)
+            << " ms, p95 " << toMillis(input_to_lock.p95_ns)
+            << " ms, max " << toMillis(input_to_lock.max_ns) << " ms\n";
+    }
+    else
+        out << "  no locks after input\n";
+
+    out << "Garbage timeline:\n";
+    if (garbage.empty())
+        out << "  no garbage\n";
+    for (const auto& entry : garbage) {
+        out << "  " << std::setw(9) << std::setprecision(3) << toSeconds(entry.time_ns) << " s"
+            << "  player " << static_cast<int>(entry.device)
+            << "  " << static_cast<unsigned>(entry.lines) << (entry.raised ? " raised\n" : " queued\n");
+    }
+}
+
+} // namespace Trace
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "game/WellEvent.h"
+#include "system/Event.h"
+
+#include <array>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+
+namespace Trace {
+
+struct LatencyStats {
+    uint64_t count;
+    uint64_t min_ns;
+    uint64_t max_ns;
+    uint64_t mean_ns;
+    uint64_t p95_ns;
+};
+
+struct GarbageEntry {
+    uint64_t time_ns;
+    DeviceID device;
+    bool raised; ///< false if the lines were only queued
+    uint8_t lines;
+};
+
+/// The aggregated statistics of a trace file
+struct Summary {
+    static constexpr unsigned input_type_count = static_cast<unsigned>(InputType::MENU_CANCEL) + 1;
+
+    uint64_t record_count;
+    uint64_t duration_ns;
+    uint64_t updates;
+    uint64_t renders;
+    uint64_t render_interval_max_ns; ///< the longest time between two presented frames
+    uint64_t frames_with_allocations; ///< only counted in debug builds
+    unsigned max_frame_allocations;
+    std::array<uint64_t, input_type_count> key_presses;
+    std::array<uint64_t, WellEvent::type_count> well_events;
+    /// The time from a player's last input to the lock of their piece
+    LatencyStats input_to_lock;
+    std::vector<GarbageEntry> garbage;
+
+    /// Read and aggregate a trace file. Throws `std::runtime_error`
+    /// if the file can not be read or is not a valid trace.
+    static Summary fromFile(const std::string& path);
+
+    /// Print the statistics in a human readable form
+    void print(std::ostream&) const;
+};
+
+} // namespace Trace
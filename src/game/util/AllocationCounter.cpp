@@ -0,0 +1,54 @@
+#include "AllocationCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+
+#ifndef NDEBUG
+namespace {
+// every thread counts its own allocations, so the worker threads
+// don't affect the counts of the main loop
+thread_local uint64_t allocation_count = 0;
+} // namespace
+
+void* operator new(size_t size)
+{
+    allocation_count++;
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+#endif
+
+
+namespace AllocationCounter {
+
+bool enabled()
+{
+#ifndef NDEBUG
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint64_t count()
+{
+#ifndef NDEBUG
+    return allocation_count;
+#else
+    return 0;
+#endif
+}
+
+} // namespace AllocationCounter
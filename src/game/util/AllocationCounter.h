@@ -0,0 +1,17 @@
+#pragma once
+
+#include <stdint.h>
+
+
+/// Counts the heap allocations made through `operator new`, to find the
+/// allocations of the per-frame code paths. The counting is only enabled
+/// in debug builds, where the global `operator new` is replaced.
+namespace AllocationCounter {
+
+/// Returns true if the allocations are counted in this build
+bool enabled();
+/// The number of allocations made by the calling thread since its start,
+/// or zero if the counting is disabled
+uint64_t count();
+
+} // namespace AllocationCounter
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <assert.h>
+
+
+template <typename Signature, size_t Capacity = 6 * sizeof(void*)>
+class Delegate;
+
+/// A move-only replacement of `std::function`, which never allocates:
+/// the callable (usually a lambda) is stored inside the delegate itself.
+/// Callables that do not fit into `Capacity` bytes are rejected at compile time.
+template <typename R, typename... Args, size_t Capacity>
+class Delegate<R(Args...), Capacity> {
+public:
+    Delegate() : invoke_fn(nullptr), manage_fn(nullptr) {}
+
+    template <typename Fn,
+              typename = typename std::enable_if<!std::is_same<typename std::decay<Fn>::type, Delegate>::value>::type>
+    Delegate(Fn&& fn)
+        : invoke_fn(&invokeStored<typename std::decay<Fn>::type>)
+        , manage_fn(&manageStored<typename std::decay<Fn>::type>)
+    {
+        using Stored = typename std::decay<Fn>::type;
+        static_assert(sizeof(Stored) <= Capacity, "The callable is too large for the Delegate");
+        static_assert(alignof(Stored) <= alignof(Storage), "The callable is overaligned for the Delegate");
+        static_assert(std::is_nothrow_move_constructible<Stored>::value, "The callable must be nothrow movable");
+        new (&storage) Stored(std::forward<Fn>(fn));
+    }
+
+    Delegate(Delegate&& other) noexcept
+        : invoke_fn(other.invoke_fn)
+        , manage_fn(other.manage_fn)
+    {
+        if (manage_fn)
+            manage_fn(&other.storage, &storage);
+        other.invoke_fn = nullptr;
+        other.manage_fn = nullptr;
+    }
+
+    Delegate& operator=(Delegate&& other) noexcept {
+        if (this != &other) {
+            reset();
+            invoke_fn = other.invoke_fn;
+            manage_fn = other.manage_fn;
+            if (manage_fn)
+                manage_fn(&other.storage, &storage);
+            other.invoke_fn = nullptr;
+            other.manage_fn = nullptr;
+        }
+        return *this;
+    }
+
+    Delegate(const Delegate&) = delete;
+    Delegate& operator=(const Delegate&) = delete;
+
+    ~Delegate() { reset(); }
+
+    explicit operator bool() const { return invoke_fn != nullptr; }
+
+    R operator()(Args... args) const {
+        assert(invoke_fn);
+        return invoke_fn(&storage, std::forward<Args>(args)...);
+    }
+
+private:
+    using Storage = typename std::aligned_storage<Capacity, alignof(std::max_align_t)>::type;
+
+    mutable Storage storage;
+    R (*invoke_fn)(void*, Args&&...);
+    /// Moves the callable from the first storage to the second one if it's set,
+    /// otherwise destroys the callable in the first storage.
+    void (*manage_fn)(void*, void*);
+
+    void reset() {
+        if (manage_fn)
+            manage_fn(&storage, nullptr);
+        invoke_fn = nullptr;
+        manage_fn = nullptr;
+    }
+
+    template <typename Stored>
+    static R invokeStored(void* stored, Args&&... args) {
+        return (*static_cast<Stored*>(stored))(std::forward<Args>(args)...);
+    }
+
+    template <typename Stored>
+    static void manageStored(void* src, void* dst) {
+        Stored* src_fn = static_cast<Stored*>(src);
+        if (dst)
+            new (dst) Stored(std::move(*src_fn));
+        src_fn->~Stored();
+    }
+};
@@ -0,0 +1,60 @@
+#include "PackBits.h"
+
+
+namespace PackBits {
+
+namespace {
+constexpr size_t max_block = 128;
+} // namespace
+
+void encode(const uint8_t* data, size_t length, std::vector<uint8_t>& out)
+{
+    size_t pos = 0;
+    while (pos < length) {
+        size_t run = 1;
+        while (pos + run < length && run < max_block && data[pos + run] == data[pos])
+            run++;
+
+        if (run > 1) {
+            out.push_back(static_cast<uint8_t>(257 - run));
+            out.push_back(data[pos]);
+            pos += run;
+            continue;
+        }
+
+        // collect literals until a run of at least two equal bytes
+        size_t literal = 1;
+        while (pos + literal < length && literal < max_block) {
+            if (pos + literal + 1 < length && data[pos + literal] == data[pos + literal + 1])
+                break;
+            literal++;
+        }
+
+        out.push_back(static_cast<uint8_t>(literal - 1));
+        out.insert(out.end(), data + pos, data + pos + literal);
+        pos += literal;
+    }
+}
+
+bool decode(const uint8_t* data, size_t length, std::vector<uint8_t>& out)
+{
+    size_t pos = 0;
+    while (pos < length) {
+        const uint8_t header = data[pos++];
+        if (header < 128) {
+            const size_t literal = header + 1u;
+            if (pos + literal > length)
+                return false;
+            out.insert(out.end(), data + pos, data + pos + literal);
+            pos += literal;
+        }
+        else if (header > 128) {
+            if (pos >= length)
+                return false;
+            out.insert(out.end(), 257u - header, data[pos++]);
+        }
+    }
+    return true;
+}
+
+} // namespace PackBits
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+
+/// PackBits run-length compression. A header byte N in [0, 127] is followed
+/// by N + 1 literal bytes, while a header byte N in [129, 255] means the
+/// next byte is repeated 257 - N times.
+namespace PackBits {
+
+/// Compress the data, appending the result to `out`
+void encode(const uint8_t* data, size_t length, std::vector<uint8_t>& out);
+/// Decompress the data, appending the result to `out`.
+/// Returns false if the data ends in the middle of a block.
+bool decode(const uint8_t* data, size_t length, std::vector<uint8_t>& out);
+
+} // namespace PackBits
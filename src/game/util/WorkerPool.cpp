@@ -0,0 +1,79 @@
+#include "WorkerPool.h"
+
+
+WorkerPool::WorkerPool(unsigned thread_count)
+    : generation(0)
+    , busy_workers(0)
+    , stopping(false)
+    , task_fn(nullptr)
+    , task_ctx(nullptr)
+    , task_count(0)
+    , next_index(0)
+{
+    threads.reserve(thread_count);
+    for (unsigned i = 0; i < thread_count; i++)
+        threads.emplace_back(&WorkerPool::workerLoop, this);
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cv_start.notify_all();
+    for (auto& thread : threads)
+        thread.join();
+}
+
+void WorkerPool::run(size_t count, TaskFn fn, void* ctx)
+{
+    if (threads.empty() || count < 2) {
+        for (size_t i = 0; i < count; i++)
+            fn(ctx, i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task_fn = fn;
+        task_ctx = ctx;
+        task_count = count;
+        next_index = 0;
+        busy_workers = threads.size();
+        generation++;
+    }
+    cv_start.notify_all();
+
+    runTasks();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    cv_done.wait(lock, [this]{ return busy_workers == 0; });
+}
+
+void WorkerPool::runTasks()
+{
+    size_t index;
+    while ((index = next_index++) < task_count)
+        task_fn(task_ctx, index);
+}
+
+void WorkerPool::workerLoop()
+{
+    unsigned seen_generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv_start.wait(lock, [&]{ return stopping || generation != seen_generation; });
+            if (stopping)
+                return;
+            seen_generation = generation;
+        }
+
+        runTasks();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busy_workers == 0)
+            cv_done.notify_one();
+    }
+}
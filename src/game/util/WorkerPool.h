@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <stddef.h>
+
+
+/// A small set of persistent threads for running short, independent tasks
+/// in parallel, like updating the wells of the players every frame.
+/// The pool is meant to be used from one thread only.
+class WorkerPool {
+public:
+    /// Start `thread_count` threads; the calling thread also takes part in the work,
+    /// so with zero threads everything runs sequentially.
+    explicit WorkerPool(unsigned thread_count);
+    ~WorkerPool();
+
+    /// Call `fn(index)` for every index in [0, count), distributed between the threads,
+    /// and return when every call has finished. The calls must not depend on each other.
+    template <typename Fn>
+    void parallelFor(size_t count, Fn& fn) {
+        run(count, &invokeTask<Fn>, &fn);
+    }
+
+    unsigned threadCount() const { return threads.size(); }
+
+private:
+    using TaskFn = void (*)(void*, size_t);
+
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable cv_start;
+    std::condition_variable cv_done;
+    unsigned generation;
+    unsigned busy_workers;
+    bool stopping;
+
+    TaskFn task_fn;
+    void* task_ctx;
+    size_t task_count;
+    std::atomic<size_t> next_index;
+
+    void run(size_t count, TaskFn, void* ctx);
+    void runTasks();
+    void workerLoop();
+
+    template <typename Fn>
+    static void invokeTask(void* fn, size_t index) {
+        (*static_cast<Fn*>(fn))(index);
+    }
+};
@@ -17,27 +17,121 @@
 
 #include "version.h"
 #include "game/AppContext.h"
+#include "game/FramePacer.h"
 #include "game/GameState.h"
 #include "game/Timing.h"
+#include "game/bot/DatasetWriter.h"
+#include "game/bot/SelfPlay.h"
+#include "game/components/PieceFactory.h"
+#include "game/components/rotations/SRS.h"
 #include "game/states/InitState.h"
+#include "game/trace/TraceRecorder.h"
+#include "game/trace/TraceSummary.h"
+#include "game/util/AllocationCounter.h"
+#include "system/GraphicsContext.h"
 #include "system/Log.h"
 #include "system/Paths.h"
 #include "system/util/MakeUnique.h"
 
 #include <algorithm>
 #include <chrono>
+#include <iostream>
 #include <memory>
-#include <thread>
+#include <vector>
 #include <assert.h>
 
 
 const std::string LOG_MAIN = "main";
 const std::string LOG_HELP = "help";
 
+int runSelfPlay(const std::string& path, const Bot::SelfPlay::Settings& settings)
+{
+    PieceFactory::changeInitialPositions(Rotations::SRS().initialPositions());
+
+    try {
+        Bot::DatasetWriter writer(path);
+        const auto stats = Bot::SelfPlay(settings).run(writer);
+        if (!writer.finish())
+            return 1;
+
+        const auto seconds = std::chrono::duration_cast<std::chrono::duration<double>>(stats.duration).count();
+        Log::info(LOG_MAIN) << "Played " << stats.games << " games, saved " << stats.positions
+                            << " positions in " << seconds << " seconds ("
+                            << static_cast<unsigned long long>(stats.positions / std::max(seconds, 0.001) * 3600)
+                            << " positions per hour)\n";
+    }
+    catch (const std::exception& err) {
+        Log::error(LOG_MAIN) << err.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+int runTraceSummary(const std::string& path)
+{
+    try {
+        Trace::Summary::fromFile(path).print(std::cout);
+    }
+    catch (const std::exception& err) {
+        Log::error(LOG_MAIN) << err.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+std::unique_ptr<FramePacer> createFramePacer(GraphicsContext& gcx, FramePacing mode, Duration interval)
+{
+    if (!gcx.setVSync(mode != FramePacing::TIMER)) {
+        Log::warning(LOG_MAIN) << "VSync is not available, using timer based frame pacing\n";
+        mode = FramePacing::TIMER;
+    }
+    return std::make_unique<FramePacer>(mode, interval);
+}
+
+void logFramePacerStats(const FramePacer& pacer)
+{
+    using Millisec = std::chrono::duration<double, std::milli>;
+    const auto& stats = pacer.stats();
+    if (!stats.count)
+        return;
+
+    Log::info(LOG_MAIN) << "Presented " << stats.count << " frames, interval "
+                        << Millisec(stats.mean).count() << " ms, jitter "
+                        << Millisec(stats.jitter).count() << " ms, max "
+                        << Millisec(stats.max).count() << " ms, "
+                        << stats.late_frames << " late frames\n";
+    if (AllocationCounter::enabled()) {
+        Log::info(LOG_MAIN) << stats.allocating_frames << " frames made heap allocations, at most "
+                            << stats.max_allocations << " per frame\n";
+    }
+}
+
+bool readNumberArg(int argc, const char** argv, int& arg_i, unsigned& out)
+{
+    const std::string arg = argv[arg_i];
+    if (++arg_i >= argc) {
+        Log::error(LOG_MAIN) << "'" << arg << "' requires a number as parameter!\n";
+        return false;
+    }
+    try { out = std::stoul(argv[arg_i]); }
+    catch (const std::exception&) {
+        Log::error(LOG_MAIN) << "Invalid number '" << argv[arg_i] << "' for '" << arg << "'!\n";
+        return false;
+    }
+    return true;
+}
+
 int main(int argc, const char** argv)
 {
     Log::info(LOG_MAIN) << "OpenBlok, created by Mátyás Mustoha, " << game_version << "\n";
 
+    std::string selfplay_path;
+    Bot::SelfPlay::Settings selfplay_settings;
+    std::string trace_path;
+    std::string trace_summary_path;
+    bool headless = false;
+    std::string record_path;
+
     for (int arg_i = 1; arg_i < argc; arg_i++) {
         std::string arg = argv[arg_i];
         if (arg == "-v" || arg == "--version")
@@ -47,6 +141,18 @@ int main(int argc, const char** argv)
             Log::info(LOG_HELP) << "  -v, --version            Display the version number then quit\n";
             Log::info(LOG_HELP) << "  --help                   Display this help then quit\n";
             Log::info(LOG_HELP) << "  --data <dir>             Load game resources from the <dir> directory\n";
+            Log::info(LOG_HELP) << "  --headless               Draw the frames into memory only, without a display\n";
+            Log::info(LOG_HELP) << "                           or sound device\n";
+            Log::info(LOG_HELP) << "  --selfplay <file>        Play bot games without a window, and save every\n";
+            Log::info(LOG_HELP) << "                           position to <file>, then quit\n";
+            Log::info(LOG_HELP) << "  --selfplay-games <n>     The number of self-play games (default: 1000)\n";
+            Log::info(LOG_HELP) << "  --selfplay-threads <n>   The number of self-play threads (default: all cores)\n";
+            Log::info(LOG_HELP) << "  --selfplay-seed <n>      The random seed of the self-play games (default: 0)\n";
+            Log::info(LOG_HELP) << "  --selfplay-versus        Play bot-vs-bot games instead of solo ones\n";
+            Log::info(LOG_HELP) << "  --record <file>          Record the game as an uncompressed Y4M video to <file>\n";
+            Log::info(LOG_HELP) << "                           (which can also be a named pipe)\n";
+            Log::info(LOG_HELP) << "  --trace <file>           Record the inputs and game events to <file>\n";
+            Log::info(LOG_HELP) << "  --trace-summary <file>   Print the statistics of a recorded trace, then quit\n";
             return 0;
         }
         else if (arg == "--data") {
@@ -56,18 +162,85 @@ int main(int argc, const char** argv)
             }
             Paths::changeDataDir(argv[arg_i]);
         }
+        else if (arg == "--headless")
+            headless = true;
+        else if (arg == "--selfplay") {
+            if (++arg_i >= argc) {
+                Log::error(LOG_MAIN) << "'--selfplay' requires a file path as parameter!\n";
+                return 1;
+            }
+            selfplay_path = argv[arg_i];
+        }
+        else if (arg == "--selfplay-games") {
+            if (!readNumberArg(argc, argv, arg_i, selfplay_settings.game_count))
+                return 1;
+        }
+        else if (arg == "--selfplay-threads") {
+            if (!readNumberArg(argc, argv, arg_i, selfplay_settings.thread_count))
+                return 1;
+        }
+        else if (arg == "--selfplay-seed") {
+            unsigned seed = 0;
+            if (!readNumberArg(argc, argv, arg_i, seed))
+                return 1;
+            selfplay_settings.seed = seed;
+        }
+        else if (arg == "--selfplay-versus")
+            selfplay_settings.versus = true;
+        else if (arg == "--record") {
+            if (++arg_i >= argc) {
+                Log::error(LOG_MAIN) << "'--record' requires a file path as parameter!\n";
+                return 1;
+            }
+            record_path = argv[arg_i];
+        }
+        else if (arg == "--trace") {
+            if (++arg_i >= argc) {
+                Log::error(LOG_MAIN) << "'--trace' requires a file path as parameter!\n";
+                return 1;
+            }
+            trace_path = argv[arg_i];
+        }
+        else if (arg == "--trace-summary") {
+            if (++arg_i >= argc) {
+                Log::error(LOG_MAIN) << "'--trace-summary' requires a file path as parameter!\n";
+                return 1;
+            }
+            trace_summary_path = argv[arg_i];
+        }
         else {
             Log::error(LOG_MAIN) << "Unknown parameter '" << arg << "'.\n";
             return 1;
         }
     }
 
+    if (!selfplay_path.empty())
+        return runSelfPlay(selfplay_path, selfplay_settings);
+    if (!trace_summary_path.empty())
+        return runTraceSummary(trace_summary_path);
+
 
     AppContext app;
-    if (!app.init())
+    if (!app.init(headless))
         return 1;
 
 
+    if (!record_path.empty()) {
+        try { app.window().startRecording(record_path); }
+        catch (const std::exception& err) {
+            app.window().showErrorMessage(err.what());
+            return 1;
+        }
+    }
+
+    if (!trace_path.empty()) {
+        try { app.setTracer(std::make_unique<Trace::Recorder>(trace_path)); }
+        catch (const std::exception& err) {
+            app.window().showErrorMessage(err.what());
+            return 1;
+        }
+    }
+
     try { app.states().emplace(std::make_unique<InitState>(app)); }
     catch (const std::exception& err) {
         app.window().showErrorMessage(err.what());
@@ -75,38 +248,87 @@ int main(int argc, const char** argv)
     }
 
 
+    // the game logic runs at a fixed rate, while the frames are drawn at the refresh
+    // rate of the display, with the visual-only animations advanced by the real time
+    const unsigned refresh_rate = app.window().refreshRate();
+    const Duration render_interval = refresh_rate
+        ? std::min<Duration>(Timing::frame_duration, Duration(std::chrono::seconds(1)) / refresh_rate)
+        : Timing::frame_duration;
+    Log::info(LOG_MAIN) << "Drawing at " << (refresh_rate ? refresh_rate : 60) << " Hz\n";
+
     auto frame_starttime = std::chrono::steady_clock::now();
-    auto frame_planned_endtime = frame_starttime + Timing::frame_duration;
     auto gametime_delay = Timing::frame_duration; // start with an update
+    auto animation_delay = Duration::zero();
+    std::vector<Event> events;
+    uint64_t frame_allocation_base = AllocationCounter::count();
+    const GameState* drawn_state = nullptr;
+
+    std::unique_ptr<FramePacer> pacer;
+    FramePacing pacing_setting = app.sysconfig().frame_pacing;
 
     while (!app.window().quitRequested()) {
+        if (!pacer || pacing_setting != app.sysconfig().frame_pacing) {
+            if (pacer)
+                logFramePacerStats(*pacer);
+            pacing_setting = app.sysconfig().frame_pacing;
+            pacer = createFramePacer(app.gcx(), pacing_setting, render_interval);
+        }
+
+        // the input is collected right after the wait, so it's as fresh as possible
+        pacer->waitForNextFrame();
+
+        const auto now = std::chrono::steady_clock::now();
+        gametime_delay += now - frame_starttime;
+        animation_delay = now - frame_starttime;
+        frame_starttime = now;
+
         try {
+            bool redraw = false;
             while (gametime_delay >= Timing::frame_duration && !app.states().empty()) {
-                auto events = app.window().collectEvents();
+                app.window().collectEvents(events);
+                // the animations of the state advance in this update
+                redraw |= !events.empty() || app.states().top()->needsRedraw();
+                if (app.tracer()) {
+                    app.tracer()->markUpdate();
+                    for (const auto& event : events) {
+                        if (event.type == EventType::INPUT)
+                            app.tracer()->recordInput(event.input);
+                    }
+                }
                 app.states().top()->update(events, app);
                 gametime_delay -= Timing::frame_duration;
             }
             if (app.states().empty())
                 break;
 
-            app.states().top()->draw(app.gcx());
-            app.gcx().render();
+            GameState* current_state = app.states().top().get();
+            current_state->updateAnimations(animation_delay);
+
+            // if nothing changed, the previously presented frame stays on the screen
+            redraw |= current_state != drawn_state || current_state->needsRedraw();
+            if (redraw) {
+                drawn_state = current_state;
+                current_state->draw(app.gcx());
+                pacer->markSubmit();
+                app.gcx().render();
+                pacer->markPresent();
+
+                const uint64_t allocations = AllocationCounter::count();
+                pacer->recordAllocations(allocations - frame_allocation_base);
+                if (app.tracer())
+                    app.tracer()->markRender(allocations - frame_allocation_base);
+                frame_allocation_base = allocations;
+            }
         }
         catch (const std::exception& err) {
             app.window().showErrorMessage(err.what());
             return 1;
         }
-
-        auto lag = std::max(std::chrono::steady_clock::now() - frame_planned_endtime, Duration::zero());
-        gametime_delay += Timing::frame_duration + lag;
-
-        // max frame rate limiting
-        std::this_thread::sleep_until(frame_planned_endtime);
-
-        frame_starttime = std::chrono::steady_clock::now();
-        frame_planned_endtime = frame_starttime + Timing::frame_duration;
     }
 
+    if (pacer)
+        logFramePacerStats(*pacer);
+
     // save input config on exit
     const auto mappings = app.window().createInputConfig();
     app.inputconfig().save(mappings, Paths::config() + "input.cfg");
@@ -52,6 +52,7 @@ enum class WindowEvent : uint8_t {
     RESIZED,
     FOCUS_LOST,
     FOCUS_GAINED,
+    EXPOSED, ///< the window has to be redrawn
 };
 
 
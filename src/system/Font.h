@@ -17,4 +17,20 @@ public:
                                                 TextAlign align = TextAlign::LEFT) = 0;
     virtual std::unique_ptr<Texture> renderText(const std::string&, const RGBAColor&,
                                                 TextAlign align = TextAlign::LEFT) = 0;
+
+    /// Draw left aligned text directly on the screen, using a glyph atlas of the font.
+    /// The glyphs are rendered on their first use only, so unlike `renderText`,
+    /// no textures are created; use this for frequently changing text, like counters.
+    virtual void drawText(const std::string&, int x, int y, const RGBAColor&) = 0;
+    /// The width of the longest line of the text, when drawn with `drawText`.
+    virtual int textWidth(const std::string&) = 0;
+
+    /// Prepare the glyphs of the printable ASCII characters for `drawText` and `textWidth`,
+    /// so the first use of a character during the game doesn't allocate.
+    void preloadAsciiGlyphs() {
+        std::string chars;
+        for (char c = ' '; c <= '~'; c++)
+            chars += c;
+        textWidth(chars);
+    }
 };
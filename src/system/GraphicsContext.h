@@ -3,13 +3,21 @@
 #include "Color.h"
 #include "Rectangle.h"
 
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 
 class Font;
 class Texture;
 
+/// An image file to be packed into a texture atlas, and the tint it should be multiplied with
+struct AtlasImage {
+    std::string path;
+    RGBColor tint;
+};
+
 /// The graphics context interface used by the game.
 ///
 /// The implementation's task is to provide a way to draw inside the graphical window,
@@ -23,6 +31,9 @@ public:
     /// Called at the end of every frame, `render()` should update
     /// the displayed image of the game window.
     virtual void render() = 0;
+    /// Make `render()` wait for the vertical blank of the display.
+    /// Returns false if this is not supported.
+    virtual bool setVSync(bool enabled) = 0;
 
     virtual unsigned short screenWidth() const = 0;
     virtual unsigned short screenHeight() const = 0;
@@ -37,6 +48,22 @@ public:
     /// Load an image file as texture with additional tinting.
     virtual std::unique_ptr<Texture> loadTexture(const std::string& path, const RGBColor& tint) = 0;
 
+    /// Load multiple image files into a single texture. Every file is decoded only once,
+    /// and the tints are applied to the pixels. `regions` will contain the area of
+    /// every image inside the atlas, in the same order as `images`.
+    virtual std::unique_ptr<Texture> loadTextureAtlas(const std::vector<AtlasImage>& images,
+                                                      std::vector<Rectangle>& regions) = 0;
+
+    /// Create an empty, transparent texture that can be drawn into with `drawIntoTexture`.
+    virtual std::unique_ptr<Texture> createRenderTarget(unsigned width, unsigned height) = 0;
+    /// Increased every time the contents of the render targets are lost (eg. when the
+    /// graphics device is reset); the cached render targets have to be redrawn then.
+    virtual unsigned renderTargetGeneration() const = 0;
+    /// Clear a texture created by `createRenderTarget`, then redirect every drawing
+    /// inside `draw_fn` into it. Drawing starts with a draw scale of 1.0, and the
+    /// original draw scale is restored afterwards.
+    virtual void drawIntoTexture(Texture& target, const std::function<void()>& draw_fn) = 0;
+
     /// Draw a rectangle on the screen, defined by [x,y,w,h], filled with [r,g,b]
     virtual void drawFilledRect(const Rectangle& rectangle, const RGBColor& color) = 0;
     /// Draw a rectangle on the screen, defined by [x,y,w,h], filled with the optionally transparent color [r,g,b,a]
@@ -7,7 +7,12 @@
 
 std::unique_ptr<Window> Window::create()
 {
-    return std::make_unique<SDLWindow>();
+    return std::make_unique<SDLWindow>(960, 540, false);
+}
+
+std::unique_ptr<Window> Window::createHeadless(unsigned width, unsigned height)
+{
+    return std::make_unique<SDLWindow>(width, height, true);
 }
 
 void Window::showErrorMessage(const std::string& content)
@@ -22,9 +22,18 @@ public:
 
     /// Change between windowed and fullscreen mode.
     virtual void toggleFullscreen() = 0;
-    /// Save a screenshot of the game window to the provided path
-    /// at the end of the current render cycle
+    /// The refresh rate of the display the window is on, in Hz, or 0 if unknown.
+    virtual unsigned refreshRate() const = 0;
+    /// Save a screenshot of the game window to the provided path as a PNG image
+    /// at the end of the current render cycle. The image is saved in the background.
     virtual void requestScreenshot(const std::string& path) = 0;
+    /// Record every rendered frame into an uncompressed Y4M video at the provided path,
+    /// which may also be a named pipe. The frames are written in the background.
+    /// Throws `std::runtime_error` if the file can not be opened.
+    virtual void startRecording(const std::string& path) = 0;
+    virtual void stopRecording() = 0;
+    /// Block until the requested screenshots and recorded frames are written out
+    virtual void waitForCaptures() = 0;
 
     /// Return the graphics context component of the window,
     /// which can be used for drawing on this window.
@@ -34,10 +43,11 @@ public:
     virtual AudioContext& audioContext() = 0;
 
     /// In every frame, the Window should collect the native events,
-    /// and return them in a platform-independent format.
+    /// and store them in `output` in a platform-independent format, replacing
+    /// its previous contents. Reusing the same vector every frame avoids allocations.
     /// If the user wants to quit the game by a native event, then after this call
     /// `quit_requested()` should return true.
-    virtual std::vector<Event> collectEvents() = 0;
+    virtual void collectEvents(std::vector<Event>& output) = 0;
     /// Return `true` if the user wants to quit the program, eg. by closing the game
     /// window or pressing certain key combinations (Alt-F4, Ctrl-Q, ...).
     virtual bool quitRequested() = 0;
@@ -58,6 +68,11 @@ public:
     /// provided content text. This operation should work even without a Window object.
     static void showErrorMessage(const std::string& content);
 
+    /// Create a window that is never shown: the frames are drawn by a software renderer
+    /// into an in-memory surface, and the sound is discarded, so it works on machines
+    /// without a display or sound device too (eg. for tests and benchmarks).
+    static std::unique_ptr<Window> createHeadless(unsigned width, unsigned height);
+
 private:
     static std::unique_ptr<Window> create();
 
@@ -0,0 +1,101 @@
+#include "Y4MWriter.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <assert.h>
+
+
+namespace {
+// BT.601 full range conversion, in 8.8 fixed point
+uint8_t lumaOf(unsigned r, unsigned g, unsigned b)
+{
+    return (77 * r + 150 * g + 29 * b + 128) >> 8;
+}
+
+uint8_t chromaBlueOf(int r, int g, int b)
+{
+    return std::min((-43 * r - 85 * g + 128 * b + 32896) >> 8, 255);
+}
+
+uint8_t chromaRedOf(int r, int g, int b)
+{
+    return std::min((128 * r - 107 * g - 21 * b + 32896) >> 8, 255);
+}
+} // namespace
+
+
+Y4MWriter::Y4MWriter(const std::string& path, unsigned fps)
+    : out(path, std::ios::binary)
+    , fps(fps)
+    , width(0)
+    , height(0)
+    , frame_count(0)
+{
+    assert(fps > 0);
+    if (!out.is_open())
+        throw std::runtime_error("Could not create the video file " + path);
+}
+
+void Y4MWriter::setFrame(const uint32_t* pixels, unsigned src_width, unsigned src_height)
+{
+    assert(pixels);
+    if (!width) {
+        assert(src_width && src_height);
+        width = src_width;
+        height = src_height;
+        // the samples use the full 0-255 range (JPEG style), not the TV range
+        out << "YUV4MPEG2 W" << width << " H" << height << " F" << fps << ":1 Ip A1:1 C420jpeg XCOLORRANGE=FULL\n";
+    }
+
+    const unsigned chroma_width = (width + 1) / 2;
+    const unsigned chroma_height = (height + 1) / 2;
+    planes.resize(width * height + 2 * chroma_width * chroma_height);
+    uint8_t* const plane_y = planes.data();
+    uint8_t* const plane_u = plane_y + width * height;
+    uint8_t* const plane_v = plane_u + chroma_width * chroma_height;
+
+    // the pixels outside of the source frame are black
+    auto pixel = [&](unsigned x, unsigned y) -> uint32_t {
+        return (x < src_width && y < src_height) ? pixels[y * src_width + x] : 0;
+    };
+
+    for (unsigned y = 0; y < height; y++) {
+        for (unsigned x = 0; x < width; x++) {
+            const uint32_t argb = pixel(x, y);
+            plane_y[y * width + x] = lumaOf((argb >> 16) & 0xFF, (argb >> 8) & 0xFF, argb & 0xFF);
+        }
+    }
+
+    // every chroma sample is the average of (at most) 2x2 pixels
+    for (unsigned cy = 0; cy < chroma_height; cy++) {
+        for (unsigned cx = 0; cx < chroma_width; cx++) {
+            int r = 0, g = 0, b = 0, count = 0;
+            for (unsigned y = cy * 2; y < std::min(cy * 2 + 2, height); y++) {
+                for (unsigned x = cx * 2; x < std::min(cx * 2 + 2, width); x++) {
+                    const uint32_t argb = pixel(x, y);
+                    r += (argb >> 16) & 0xFF;
+                    g += (argb >> 8) & 0xFF;
+                    b += argb & 0xFF;
+                    count++;
+                }
+            }
+            r /= count;
+            g /= count;
+            b /= count;
+            plane_u[cy * chroma_width + cx] = chromaBlueOf(r, g, b);
+            plane_v[cy * chroma_width + cx] = chromaRedOf(r, g, b);
+        }
+    }
+}
+
+bool Y4MWriter::writeFrames(unsigned count)
+{
+    assert(!planes.empty());
+    for (unsigned i = 0; i < count; i++) {
+        out << "FRAME\n";
+        out.write(reinterpret_cast<const char*>(planes.data()), planes.size());
+        frame_count++;
+    }
+    out.flush();
+    return out.good();
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+
+/// Writes frames as an uncompressed YUV 4:2:0 video in the YUV4MPEG2 format,
+/// which most video tools (eg. ffmpeg) can read from a file or a named pipe.
+/// The samples are full range, as marked by the `XCOLORRANGE=FULL` header tag.
+///
+/// The size of the video is the size of the first frame; later frames
+/// of a different size are cropped or padded with black.
+class Y4MWriter {
+public:
+    /// Open the output file. Throws `std::runtime_error` if it can not be created.
+    Y4MWriter(const std::string& path, unsigned fps);
+
+    /// Convert a frame of packed 0xAARRGGBB pixels, without padding between
+    /// the rows; the frame will be written by the following `writeFrames` calls
+    void setFrame(const uint32_t* pixels, unsigned width, unsigned height);
+    /// Write the current frame `count` times. Returns false if there was a write error.
+    bool writeFrames(unsigned count = 1);
+
+    unsigned long long frameCount() const { return frame_count; }
+
+private:
+    std::ofstream out;
+    const unsigned fps;
+    unsigned width;
+    unsigned height;
+    std::vector<uint8_t> planes; ///< the Y, U and V planes of the current frame
+    unsigned long long frame_count;
+};
@@ -1,17 +1,24 @@
 #include "SDLFont.h"
 
+#include "SDLSpriteBatch.h"
 #include "SDLTexture.h"
 #include "system/util/MakeUnique.h"
 
 #include "SDL2/SDL.h"
+#include <algorithm>
 #include <sstream>
 #include <vector>
 #include <assert.h>
 
 
 SDL2pp::Renderer* SDLFont::renderer = nullptr;
+SDLSpriteBatch* SDLFont::batch = nullptr;
 uint32_t SDLFont::pixelformat = 0x0;
 
+static constexpr int glyph_atlas_initial_size = 256;
+static constexpr int glyph_atlas_max_size = 2048;
+static constexpr int glyph_padding = 1;
+
 std::vector<std::string> splitByNL(const std::string& str) {
     std::vector<std::string> output;
     std::istringstream isst(str);
@@ -23,10 +30,158 @@ std::vector<std::string> splitByNL(const std::string& str) {
     return output;
 }
 
+/// Decode the next character of an UTF-8 string; characters outside
+/// the Basic Multilingual Plane and invalid bytes are replaced with '?'
+static Uint16 nextCodepoint(const std::string& str, size_t& pos)
+{
+    const auto byte = static_cast<unsigned char>(str[pos++]);
+    unsigned length = 0;
+    uint32_t codepoint = byte;
+    if ((byte & 0xE0) == 0xC0) {
+        length = 1;
+        codepoint = byte & 0x1F;
+    }
+    else if ((byte & 0xF0) == 0xE0) {
+        length = 2;
+        codepoint = byte & 0x0F;
+    }
+    else if (byte >= 0x80)
+        return '?';
+
+    for (unsigned i = 0; i < length; i++) {
+        if (pos >= str.size() || (static_cast<unsigned char>(str[pos]) & 0xC0) != 0x80)
+            return '?';
+        codepoint = (codepoint << 6) | (static_cast<unsigned char>(str[pos++]) & 0x3F);
+    }
+    return static_cast<Uint16>(codepoint);
+}
+
 SDLFont::SDLFont(SDL2pp::Font&& font)
     : font(std::move(font))
+    , atlas_size(0)
+    , shelf_x(0)
+    , shelf_y(0)
+    , shelf_height(0)
 {}
 
+SDLFont::~SDLFont()
+{
+    // the atlas may still be used by the quads waiting for submission
+    if (atlas && batch)
+        batch->release(atlas->Get());
+}
+
+void SDLFont::resetAtlas(int size)
+{
+    assert(renderer);
+    if (atlas && batch)
+        batch->release(atlas->Get());
+
+    atlas = std::make_unique<SDL2pp::Texture>(*renderer, SDL_PIXELFORMAT_ARGB8888,
+                                              SDL_TEXTUREACCESS_STATIC, size, size);
+    atlas->SetBlendMode(SDL_BLENDMODE_BLEND);
+    // the padding between the glyphs has to be transparent
+    const std::vector<uint32_t> empty_pixels(size * size, 0x0);
+    atlas->Update(SDL2pp::NullOpt, empty_pixels.data(), size * sizeof(uint32_t));
+
+    glyphs.clear();
+    atlas_size = size;
+    shelf_x = glyph_padding;
+    shelf_y = glyph_padding;
+    shelf_height = 0;
+}
+
+const SDLFont::Glyph* SDLFont::findGlyph(Uint16 codepoint)
+{
+    const auto it = glyphs.find(codepoint);
+    if (it != glyphs.end())
+        return &it->second;
+
+    if (!atlas)
+        resetAtlas(glyph_atlas_initial_size);
+
+    int minx, advance;
+    if (TTF_GlyphMetrics(font.Get(), codepoint, &minx, nullptr, nullptr, nullptr, &advance) != 0)
+        return nullptr;
+
+    SDL_Surface* rendered = TTF_RenderGlyph_Blended(font.Get(), codepoint, {255, 255, 255, 255});
+    if (!rendered)
+        return nullptr;
+    SDL2pp::Surface surface = SDL2pp::Surface(rendered).Convert(SDL_PIXELFORMAT_ARGB8888);
+    const int width = surface.GetWidth();
+    const int height = surface.GetHeight();
+    if (width + 2 * glyph_padding > glyph_atlas_max_size || height + 2 * glyph_padding > glyph_atlas_max_size)
+        return nullptr;
+
+    // start a new row if the glyph doesn't fit into the current one
+    if (shelf_x + width + glyph_padding > atlas_size) {
+        shelf_x = glyph_padding;
+        shelf_y += shelf_height + glyph_padding;
+        shelf_height = 0;
+    }
+    // if the atlas is full, start over with a larger one
+    if (shelf_x + width + glyph_padding > atlas_size || shelf_y + height + glyph_padding > atlas_size) {
+        resetAtlas(std::min(atlas_size * 2, glyph_atlas_max_size));
+        return findGlyph(codepoint);
+    }
+
+    const SDL_Rect region = {shelf_x, shelf_y, width, height};
+    atlas->Update(SDL2pp::Rect(region), surface.Get()->pixels, surface.Get()->pitch);
+    shelf_x += width + glyph_padding;
+    shelf_height = std::max(shelf_height, height);
+
+    // the rendered surface starts at the leftmost pixel, if it's left from the pen
+    const Glyph glyph = {region, std::min(minx, 0), advance};
+    return &glyphs.emplace(codepoint, glyph).first->second;
+}
+
+void SDLFont::drawText(const std::string& text, int x, int y, const RGBAColor& color)
+{
+    assert(batch);
+
+    const int line_height = font.GetLineSkip();
+    const SDL_Color modulation = {color.r, color.g, color.b, color.a};
+    int pen_x = x;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        const Uint16 codepoint = nextCodepoint(text, pos);
+        if (codepoint == '\n') {
+            pen_x = x;
+            y += line_height;
+            continue;
+        }
+
+        const Glyph* glyph = findGlyph(codepoint);
+        if (!glyph)
+            continue;
+
+        // NOTE: finding a glyph may replace the atlas, so it's queried for every glyph
+        const SDL_Rect dst = {pen_x + glyph->offset_x, y, glyph->region.w, glyph->region.h};
+        batch->add(atlas->Get(), atlas_size, atlas_size, glyph->region, dst, modulation);
+        pen_x += glyph->advance;
+    }
+}
+
+int SDLFont::textWidth(const std::string& text)
+{
+    int max_width = 0;
+    int width = 0;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        const Uint16 codepoint = nextCodepoint(text, pos);
+        if (codepoint == '\n') {
+            max_width = std::max(max_width, width);
+            width = 0;
+            continue;
+        }
+
+        const Glyph* glyph = findGlyph(codepoint);
+        if (glyph)
+            width += glyph->advance;
+    }
+    return std::max(max_width, width);
+}
+
 std::unique_ptr<Texture> SDLFont::renderText(const std::string& text, const RGBColor& color, TextAlign align)
 {
     return renderText(text, RGBAColor {color.r, color.g, color.b, 255}, align);
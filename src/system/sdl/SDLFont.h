@@ -3,18 +3,44 @@
 #include "system/Font.h"
 
 #include <SDL2pp/SDL2pp.hh>
+#include <memory>
+#include <unordered_map>
+
+class SDLSpriteBatch;
 
 
 class SDLFont : public Font {
 public:
     SDLFont(SDL2pp::Font&&);
+    ~SDLFont();
     std::unique_ptr<Texture> renderText(const std::string&, const RGBColor&, TextAlign) final;
     std::unique_ptr<Texture> renderText(const std::string&, const RGBAColor&, TextAlign) final;
 
+    void drawText(const std::string&, int x, int y, const RGBAColor&) final;
+    int textWidth(const std::string&) final;
+
 private:
     static SDL2pp::Renderer* renderer;
+    static SDLSpriteBatch* batch;
     static uint32_t pixelformat;
     SDL2pp::Font font;
 
+    struct Glyph {
+        SDL_Rect region; ///< inside the atlas
+        int offset_x; ///< from the pen position
+        int advance;
+    };
+    /// The glyphs are rendered in white, and packed into rows of the atlas as they are
+    /// requested. If the atlas becomes full, it's replaced by a larger (or a clean) one.
+    std::unordered_map<Uint16, Glyph> glyphs;
+    std::unique_ptr<SDL2pp::Texture> atlas;
+    int atlas_size;
+    int shelf_x;
+    int shelf_y;
+    int shelf_height;
+
+    void resetAtlas(int size);
+    const Glyph* findGlyph(Uint16 codepoint);
+
 friend class SDLGraphicsContext;
 };
@@ -0,0 +1,250 @@
+#include "SDLFrameCapture.h"
+
+#include "system/Log.h"
+
+#include <SDL2/SDL_image.h>
+#include <algorithm>
+#include <stdexcept>
+#include <assert.h>
+
+
+constexpr unsigned SDLFrameCapture::video_fps;
+constexpr size_t SDLFrameCapture::pool_size;
+
+const std::string LOG_CAPTURE_TAG("capture");
+
+SDLFrameCapture::SDLFrameCapture()
+    : recording(false)
+    , dropped_frames(0)
+    , busy(false)
+    , stopping(false)
+    , video_next_slot(0)
+    , video_has_frame(false)
+{
+    for (auto& frame : frames) {
+        frame.width = 0;
+        frame.height = 0;
+        free_frames.push_back(&frame);
+    }
+    thread = std::thread(&SDLFrameCapture::workerLoop, this);
+}
+
+SDLFrameCapture::~SDLFrameCapture()
+{
+    if (recording)
+        stopRecording();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cv_jobs.notify_one();
+    thread.join();
+
+    if (dropped_frames)
+        Log::warning(LOG_CAPTURE_TAG) << dropped_frames << " frames were not captured, as the encoding fell behind\n";
+}
+
+void SDLFrameCapture::requestScreenshot(const std::string& path)
+{
+    screenshot_path = path;
+}
+
+void SDLFrameCapture::startRecording(const std::string& path)
+{
+    if (recording)
+        stopRecording();
+
+    Job job;
+    job.type = JobType::VIDEO_START;
+    job.time = Clock::now();
+    job.frame = nullptr;
+    job.video_frame = false;
+    job.video = std::make_unique<Y4MWriter>(path, video_fps);
+    push(std::move(job));
+
+    recording = true;
+    Log::info(LOG_CAPTURE_TAG) << "Recording video to " << path << "\n";
+}
+
+void SDLFrameCapture::stopRecording()
+{
+    if (!recording)
+        return;
+
+    Job job;
+    job.type = JobType::VIDEO_END;
+    job.time = Clock::now();
+    job.frame = nullptr;
+    job.video_frame = false;
+    push(std::move(job));
+
+    recording = false;
+}
+
+void SDLFrameCapture::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    cv_idle.wait(lock, [this]{ return jobs.empty() && !busy; });
+}
+
+void SDLFrameCapture::push(Job&& job)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+    cv_jobs.notify_one();
+}
+
+void SDLFrameCapture::capture(SDL_Renderer* renderer)
+{
+    assert(active());
+
+    Frame* frame = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!free_frames.empty()) {
+            frame = free_frames.back();
+            free_frames.pop_back();
+        }
+    }
+    if (!frame) {
+        // a pending screenshot will be taken from a later frame
+        dropped_frames++;
+        return;
+    }
+
+    // read the whole output, regardless of the logical size and scale
+    int logical_w = 0, logical_h = 0;
+    float scale_x = 1.0, scale_y = 1.0;
+    SDL_RenderGetLogicalSize(renderer, &logical_w, &logical_h);
+    SDL_RenderGetScale(renderer, &scale_x, &scale_y);
+    SDL_RenderSetLogicalSize(renderer, 0, 0);
+
+    int width = 0, height = 0;
+    SDL_GetRendererOutputSize(renderer, &width, &height);
+    frame->width = width;
+    frame->height = height;
+    frame->pixels.resize(frame->width * frame->height);
+    const bool success = width > 0 && height > 0 && SDL_RenderReadPixels(renderer, nullptr,
+        SDL_PIXELFORMAT_ARGB8888, frame->pixels.data(), width * sizeof(uint32_t)) == 0;
+
+    if (logical_w && logical_h)
+        SDL_RenderSetLogicalSize(renderer, logical_w, logical_h);
+    SDL_RenderSetScale(renderer, scale_x, scale_y);
+
+    if (!success) {
+        Log::warning(LOG_CAPTURE_TAG) << "Could not read the frame: " << SDL_GetError() << "\n";
+        std::lock_guard<std::mutex> lock(mutex);
+        free_frames.push_back(frame);
+        return;
+    }
+
+    Job job;
+    job.type = JobType::FRAME;
+    job.time = Clock::now();
+    job.frame = frame;
+    job.screenshot_path = std::move(screenshot_path);
+    job.video_frame = recording;
+    push(std::move(job));
+
+    screenshot_path.clear();
+}
+
+void SDLFrameCapture::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        cv_jobs.wait(lock, [this]{ return stopping || !jobs.empty(); });
+        if (jobs.empty())
+            break;
+
+        Job job = std::move(jobs.front());
+        jobs.pop_front();
+        busy = true;
+        lock.unlock();
+
+        process(job);
+
+        lock.lock();
+        if (job.frame)
+            free_frames.push_back(job.frame);
+        busy = false;
+        if (jobs.empty())
+            cv_idle.notify_all();
+    }
+}
+
+void SDLFrameCapture::process(Job& job)
+{
+    switch (job.type) {
+        case JobType::VIDEO_START:
+            video = std::move(job.video);
+            video_start = job.time;
+            video_next_slot = 0;
+            video_has_frame = false;
+            break;
+
+        case JobType::FRAME:
+            assert(job.frame);
+            if (!job.screenshot_path.empty())
+                savePNG(*job.frame, job.screenshot_path);
+            if (job.video_frame && video) {
+                // the previous frame lasts until the slot of this one
+                writeVideoUntil(videoSlot(job.time));
+            }
+            if (job.video_frame && video) {
+                video->setFrame(job.frame->pixels.data(), job.frame->width, job.frame->height);
+                video_has_frame = true;
+            }
+            break;
+
+        case JobType::VIDEO_END:
+            if (video) {
+                // the last frame stays until the end, but is written at least once
+                writeVideoUntil(std::max(videoSlot(job.time), video_next_slot + 1));
+                if (video)
+                    Log::info(LOG_CAPTURE_TAG) << "Recorded " << video->frameCount() << " video frames\n";
+                video.reset();
+            }
+            break;
+    }
+}
+
+unsigned long long SDLFrameCapture::videoSlot(Clock::time_point time) const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(time - video_start).count()
+        * video_fps / 1000000;
+}
+
+void SDLFrameCapture::writeVideoUntil(unsigned long long slot)
+{
+    assert(video);
+    if (!video_has_frame || slot <= video_next_slot)
+        return;
+
+    if (!video->writeFrames(slot - video_next_slot)) {
+        Log::warning(LOG_CAPTURE_TAG) << "Could not write the video, recording stopped\n";
+        video.reset();
+        return;
+    }
+    video_next_slot = slot;
+}
+
+void SDLFrameCapture::savePNG(const Frame& frame, const std::string& path)
+{
+    SDL_Surface* surface = SDL_CreateRGBSurfaceFrom(const_cast<uint32_t*>(frame.pixels.data()),
+        frame.width, frame.height, 32, frame.width * sizeof(uint32_t),
+        0x00FF0000, 0x0000FF00, 0x000000FF, 0);
+    if (!surface) {
+        Log::warning(LOG_CAPTURE_TAG) << "Could not save screenshot: " << SDL_GetError() << "\n";
+        return;
+    }
+
+    if (IMG_SavePNG(surface, path.c_str()) == 0)
+        Log::info(LOG_CAPTURE_TAG) << "Screenshot saved to " << path << "\n";
+    else
+        Log::warning(LOG_CAPTURE_TAG) << "Could not save screenshot: " << IMG_GetError() << "\n";
+    SDL_FreeSurface(surface);
+}
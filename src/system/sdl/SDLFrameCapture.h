@@ -0,0 +1,100 @@
+#pragma once
+
+#include "system/Y4MWriter.h"
+
+#include "SDL2/SDL.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+/// Saves screenshots and records videos of the presented frames.
+///
+/// The frames are read back into a small pool of reusable buffers, and a
+/// worker thread encodes and writes them out, so the game loop never waits
+/// for the disk or the encoding. If every buffer is in use, the frame is dropped.
+/// The public functions must be called from the rendering thread only.
+class SDLFrameCapture {
+public:
+    SDLFrameCapture();
+    /// Finish the queued work, and close the recorded video
+    ~SDLFrameCapture();
+
+    /// Save the next frame as a PNG image
+    void requestScreenshot(const std::string& path);
+    /// Record every frame into an uncompressed Y4M video at `path`, which may
+    /// also be a named pipe. Throws `std::runtime_error` if it can not be opened.
+    void startRecording(const std::string& path);
+    void stopRecording();
+    /// Block until the queued frames are written out
+    void flush();
+
+    /// True if the next frame should be captured
+    bool active() const { return !screenshot_path.empty() || recording; }
+    /// Read back the current contents of the renderer's output; call before presenting
+    void capture(SDL_Renderer*);
+
+    /// The frame rate of the recorded videos; the frames presented at different
+    /// times are duplicated or dropped to fit this rate
+    static constexpr unsigned video_fps = 60;
+    static constexpr size_t pool_size = 4;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Frame {
+        std::vector<uint32_t> pixels; ///< ARGB8888
+        unsigned width;
+        unsigned height;
+    };
+    enum class JobType : uint8_t {
+        FRAME,
+        VIDEO_START,
+        VIDEO_END,
+    };
+    struct Job {
+        JobType type;
+        Clock::time_point time;
+        Frame* frame;
+        std::string screenshot_path;
+        bool video_frame;
+        std::unique_ptr<Y4MWriter> video;
+    };
+
+    // used by the rendering thread only
+    std::string screenshot_path;
+    bool recording;
+    unsigned long long dropped_frames;
+
+    // shared, guarded by the mutex
+    std::array<Frame, pool_size> frames;
+    std::vector<Frame*> free_frames;
+    std::deque<Job> jobs;
+    bool busy;
+    bool stopping;
+    std::mutex mutex;
+    std::condition_variable cv_jobs;
+    std::condition_variable cv_idle;
+
+    // used by the worker only
+    std::unique_ptr<Y4MWriter> video;
+    Clock::time_point video_start;
+    unsigned long long video_next_slot; ///< the first video frame not written yet
+    bool video_has_frame; ///< the writer has a converted frame waiting to be written
+
+    std::thread thread;
+
+    void push(Job&&);
+    void workerLoop();
+    void process(Job&);
+    void savePNG(const Frame&, const std::string& path);
+    unsigned long long videoSlot(Clock::time_point) const;
+    void writeVideoUntil(unsigned long long slot);
+};
@@ -7,6 +7,7 @@
 
 #include <SDL2/SDL_image.h>
 #include <SDL2pp/SDL2pp.hh>
+#include <algorithm>
 #include <cmath>
 #include <exception>
 #include <map>
@@ -25,7 +26,8 @@ SDLGraphicsContext::SDLGraphicsContext(SDL2pp::Window& window)
     : renderer(window, -1, 0x0)
     , image_loader(SDL_IMG_FLAGS)
     , ttf()
-    , on_render_callback([](){})
+    , sprite_batch(renderer.Get())
+    , target_generation(0)
 {
     SDL_RendererInfo rinfo;
     renderer.GetInfo(rinfo);
@@ -45,24 +47,41 @@ SDLGraphicsContext::SDLGraphicsContext(SDL2pp::Window& window)
         throw std::runtime_error(SDL_GetError());
 
     SDLTexture::renderer = &renderer;
+    SDLTexture::batch = &sprite_batch;
     SDLFont::pixelformat = pixelformat;
     SDLFont::renderer = &renderer;
+    SDLFont::batch = &sprite_batch;
 }
 
 SDLGraphicsContext::~SDLGraphicsContext()
 {
     SDLTexture::renderer = nullptr;
+    SDLTexture::batch = nullptr;
     SDLFont::renderer = nullptr;
+    SDLFont::batch = nullptr;
 }
 
 void SDLGraphicsContext::render()
 {
+    sprite_batch.flush();
+    if (capture.active())
+        capture.capture(renderer.Get());
     renderer.Present();
-    on_render_callback();
 
     renderer.Clear();
 }
 
+bool SDLGraphicsContext::setVSync(bool enabled)
+{
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (SDL_RenderSetVSync(renderer.Get(), enabled) == 0)
+        return true;
+
+    Log::warning(LOG_TAG) << "Could not change vsync: " << SDL_GetError() << "\n";
+#endif
+    return !enabled;
+}
+
 unsigned short SDLGraphicsContext::screenWidth() const
 {
     return renderer.GetLogicalWidth();
@@ -83,6 +102,8 @@ float SDLGraphicsContext::getDrawScale() const
 
 void SDLGraphicsContext::modifyDrawScale(float scale)
 {
+    // the scale is applied when the quads are submitted
+    sprite_batch.flush();
     renderer.SetScale(scale, scale);
 }
 
@@ -106,8 +127,106 @@ std::unique_ptr<Texture> SDLGraphicsContext::loadTexture(const std::string& path
     return std::make_unique<SDLTexture>(std::move(tex));
 }
 
+std::unique_ptr<Texture> SDLGraphicsContext::loadTextureAtlas(const std::vector<AtlasImage>& images,
+                                                              std::vector<Rectangle>& regions)
+{
+    assert(!images.empty());
+
+    // the edge pixels of every image are repeated around it, so scaled
+    // drawing with linear filtering doesn't blend in the neighbour images
+    constexpr int padding = 1;
+
+    std::map<std::string, SDL2pp::Surface> decoded;
+    int cell_width = 0;
+    int cell_height = 0;
+    for (const auto& image : images) {
+        auto surface = decoded.find(image.path);
+        if (surface == decoded.end()) {
+            SDL2pp::Surface rgba = SDL2pp::Surface(image.path).Convert(SDL_PIXELFORMAT_RGBA32);
+            surface = decoded.emplace(image.path, std::move(rgba)).first;
+        }
+        cell_width = std::max(cell_width, surface->second.GetWidth() + 2 * padding);
+        cell_height = std::max(cell_height, surface->second.GetHeight() + 2 * padding);
+    }
+
+    const int columns = std::ceil(std::sqrt(images.size()));
+    const int rows = (images.size() + columns - 1) / columns;
+    SDL_Surface* atlas_raw = SDL_CreateRGBSurfaceWithFormat(0,
+        columns * cell_width, rows * cell_height, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!atlas_raw)
+        throw std::runtime_error(SDL_GetError());
+    SDL2pp::Surface atlas(atlas_raw);
+
+    regions.clear();
+    uint8_t* const atlas_pixels = static_cast<uint8_t*>(atlas.Get()->pixels);
+    const int atlas_pitch = atlas.Get()->pitch;
+    for (size_t idx = 0; idx < images.size(); idx++) {
+        const auto& image = images[idx];
+        const SDL_Surface* src = decoded.at(image.path).Get();
+        const auto* src_pixels = static_cast<const uint8_t*>(src->pixels);
+
+        const Rectangle region = {
+            static_cast<int>(idx % columns) * cell_width + padding,
+            static_cast<int>(idx / columns) * cell_height + padding,
+            src->w, src->h,
+        };
+        regions.push_back(region);
+
+        for (int y = -padding; y < src->h + padding; y++) {
+            const int src_y = std::min(std::max(y, 0), src->h - 1);
+            const uint8_t* src_row = src_pixels + src_y * src->pitch;
+            uint8_t* dst_row = atlas_pixels + (region.y + y) * atlas_pitch;
+            for (int x = -padding; x < src->w + padding; x++) {
+                const int src_x = std::min(std::max(x, 0), src->w - 1);
+                const uint8_t* src_px = src_row + src_x * 4;
+                uint8_t* dst_px = dst_row + (region.x + x) * 4;
+                // the same as the color modulation of SDL
+                dst_px[0] = src_px[0] * image.tint.r / 255;
+                dst_px[1] = src_px[1] * image.tint.g / 255;
+                dst_px[2] = src_px[2] * image.tint.b / 255;
+                dst_px[3] = src_px[3];
+            }
+        }
+    }
+
+    SDL2pp::Texture tex(renderer, atlas);
+    tex.SetBlendMode(SDL_BLENDMODE_BLEND);
+    return std::make_unique<SDLTexture>(std::move(tex));
+}
+
+std::unique_ptr<Texture> SDLGraphicsContext::createRenderTarget(unsigned width, unsigned height)
+{
+    SDL2pp::Texture tex(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    tex.SetBlendMode(SDL_BLENDMODE_BLEND);
+    return std::make_unique<SDLTexture>(std::move(tex));
+}
+
+void SDLGraphicsContext::drawIntoTexture(Texture& target, const std::function<void()>& draw_fn)
+{
+    // only SDL textures are created by this context
+    auto& sdl_target = static_cast<SDLTexture&>(target);
+
+    Uint8 r, g, b, a;
+    renderer.GetDrawColor(r, g, b, a);
+    const float scale = getDrawScale();
+
+    sprite_batch.flush();
+    renderer.SetTarget(sdl_target.tex);
+    renderer.SetScale(1.0, 1.0);
+    renderer.SetDrawColor(0, 0, 0, 0);
+    renderer.Clear();
+
+    draw_fn();
+
+    sprite_batch.flush();
+    renderer.SetTarget();
+    renderer.SetScale(scale, scale);
+    renderer.SetDrawColor(r, g, b, a);
+}
+
 void SDLGraphicsContext::drawFilledRect(const Rectangle& rect, const RGBColor& color)
 {
+    sprite_batch.flush();
     Uint8 r, g, b, a;
     renderer.GetDrawColor(r, g, b, a);
     renderer.SetDrawColor(color.r, color.g, color.b);
@@ -118,6 +237,7 @@ void SDLGraphicsContext::drawFilledRect(const Rectangle& rect, const RGBColor& c
 void SDLGraphicsContext::drawFilledRect(const Rectangle& rect, const RGBAColor& color)
 {
     // TODO: fix duplication
+    sprite_batch.flush();
     Uint8 r, g, b, a;
     auto blend = renderer.GetDrawBlendMode();
     renderer.GetDrawColor(r, g, b, a);
@@ -130,13 +250,10 @@ void SDLGraphicsContext::drawFilledRect(const Rectangle& rect, const RGBAColor&
     renderer.SetDrawColor(r, g, b, a);
 }
 
-void SDLGraphicsContext::requestScreenshot(const SDL2pp::Window& window, const std::string& path)
+void SDLGraphicsContext::onRenderTargetsReset()
 {
-    // TODO: if there'll be other callbacks, then this should be a FIFO list
-    on_render_callback = [this, &window, &path](){
-        saveScreenshotBMP(window, path);
-        on_render_callback = [](){};
-    };
+    target_generation++;
+    Log::info(LOG_TAG) << "The render targets were reset, redrawing\n";
 }
 
 void SDLGraphicsContext::onResize(int width, int height)
@@ -160,37 +277,6 @@ void SDLGraphicsContext::onResize(int width, int height)
         logical_height *= height / (min_logical_h * width_ratio);
     }
 
+    sprite_batch.flush();
     renderer.SetLogicalSize(logical_width, logical_height);
 }
-
-void SDLGraphicsContext::saveScreenshotBMP(const SDL2pp::Window& window, const std::string& path)
-{
-    auto window_surface_raw = SDL_GetWindowSurface(window.Get());
-    if (!window_surface_raw)
-        throw std::runtime_error(SDL_GetError());
-
-    const SDL2pp::Surface info_surface(window_surface_raw);
-    const auto info_format = info_surface.Get()->format;
-
-    std::unique_ptr<uint8_t[]> pixels = std::make_unique<uint8_t[]>(
-        info_surface.GetWidth() * info_surface.GetHeight() * static_cast<size_t>(info_format->BytesPerPixel));
-
-    renderer.ReadPixels(
-        info_surface.GetClipRect(),
-        info_format->format,
-        pixels.get(),
-        info_surface.GetWidth() * info_format->BytesPerPixel);
-
-    SDL2pp::Surface save_surface(pixels.get(),
-        info_surface.GetWidth(),
-        info_surface.GetHeight(),
-        info_format->BitsPerPixel,
-        info_surface.GetWidth() * info_format->BytesPerPixel,
-        info_format->Rmask,
-        info_format->Gmask,
-        info_format->Bmask,
-        info_format->Amask);
-
-    SDL_SaveBMP(save_surface.Get(), path.c_str());
-    Log::info(LOG_TAG) << "Screenshot saved to " << path << "\n";
-}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "SDLFrameCapture.h"
+#include "SDLSpriteBatch.h"
 #include "system/GraphicsContext.h"
 
 #include <SDL2pp/SDL2pp.hh>
@@ -13,6 +15,7 @@ public:
     ~SDLGraphicsContext();
 
     void render() final;
+    bool setVSync(bool enabled) final;
     unsigned short screenWidth() const final;
     unsigned short screenHeight() const final;
 
@@ -22,22 +25,30 @@ public:
     std::shared_ptr<Font> loadFont(const std::string& path, unsigned pt) final;
     std::unique_ptr<Texture> loadTexture(const std::string& path) final;
     std::unique_ptr<Texture> loadTexture(const std::string& path, const RGBColor& tint) final;
+    std::unique_ptr<Texture> loadTextureAtlas(const std::vector<AtlasImage>& images,
+                                              std::vector<Rectangle>& regions) final;
+
+    std::unique_ptr<Texture> createRenderTarget(unsigned width, unsigned height) final;
+    unsigned renderTargetGeneration() const final { return target_generation; }
+    void drawIntoTexture(Texture& target, const std::function<void()>& draw_fn) final;
 
     void drawFilledRect(const Rectangle& rect, const RGBColor& color) final;
     void drawFilledRect(const Rectangle& rect, const RGBAColor& color) final;
 
     // SDL only
-    void requestScreenshot(const SDL2pp::Window&, const std::string& path);
+    SDLFrameCapture& frameCapture() { return capture; }
     void onResize(int width, int height);
+    /// Called when the contents of the render targets were lost
+    void onRenderTargetsReset();
 
 private:
     SDL2pp::Renderer renderer;
     SDL2pp::SDLImage image_loader;
     SDL2pp::SDLTTF ttf;
     uint32_t pixelformat;
+    SDLSpriteBatch sprite_batch;
+    SDLFrameCapture capture;
+    unsigned target_generation;
 
     std::map<std::string, std::shared_ptr<Font>> font_cache;
-
-    std::function<void()> on_render_callback;
-    void saveScreenshotBMP(const SDL2pp::Window&, const std::string& path);
 };
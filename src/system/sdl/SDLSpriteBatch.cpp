@@ -0,0 +1,78 @@
+#include "SDLSpriteBatch.h"
+
+#include <assert.h>
+
+
+SDLSpriteBatch::SDLSpriteBatch(SDL_Renderer* renderer)
+    : renderer(renderer)
+    , current_texture(nullptr)
+{
+    assert(renderer);
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    // enough for a few full wells, reused between frames
+    vertices.reserve(4 * 1024);
+    indices.reserve(6 * 1024);
+#endif
+}
+
+void SDLSpriteBatch::add(SDL_Texture* texture, int tex_w, int tex_h,
+                         const SDL_Rect& src, const SDL_Rect& dst, const SDL_Color& color)
+{
+    assert(texture);
+    assert(tex_w > 0 && tex_h > 0);
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (texture != current_texture) {
+        flush();
+        current_texture = texture;
+    }
+
+    const float u1 = static_cast<float>(src.x) / tex_w;
+    const float v1 = static_cast<float>(src.y) / tex_h;
+    const float u2 = static_cast<float>(src.x + src.w) / tex_w;
+    const float v2 = static_cast<float>(src.y + src.h) / tex_h;
+    const float x1 = dst.x;
+    const float y1 = dst.y;
+    const float x2 = dst.x + dst.w;
+    const float y2 = dst.y + dst.h;
+
+    const int first = vertices.size();
+    vertices.push_back({{x1, y1}, color, {u1, v1}});
+    vertices.push_back({{x2, y1}, color, {u2, v1}});
+    vertices.push_back({{x2, y2}, color, {u2, v2}});
+    vertices.push_back({{x1, y2}, color, {u1, v2}});
+
+    indices.push_back(first);
+    indices.push_back(first + 1);
+    indices.push_back(first + 2);
+    indices.push_back(first);
+    indices.push_back(first + 2);
+    indices.push_back(first + 3);
+#else
+    // the modulation is already set on the texture
+    (void) tex_w;
+    (void) tex_h;
+    (void) color;
+    SDL_RenderCopy(renderer, texture, &src, &dst);
+#endif
+}
+
+void SDLSpriteBatch::flush()
+{
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (!vertices.empty()) {
+        SDL_RenderGeometry(renderer, current_texture,
+                           vertices.data(), vertices.size(),
+                           indices.data(), indices.size());
+        vertices.clear();
+        indices.clear();
+    }
+#endif
+    current_texture = nullptr;
+}
+
+void SDLSpriteBatch::release(SDL_Texture* texture)
+{
+    if (texture == current_texture)
+        flush();
+}
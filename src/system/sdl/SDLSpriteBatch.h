@@ -0,0 +1,34 @@
+#pragma once
+
+#include "SDL2/SDL.h"
+#include <vector>
+
+
+/// Collects the textured quads drawn during a frame, and submits the
+/// consecutive quads of the same texture with one SDL_RenderGeometry call,
+/// instead of one copy per quad. The color and alpha modulation of the
+/// texture are stored in the vertices, so they can change between the quads.
+///
+/// The batch has to be flushed before anything is drawn with the renderer
+/// directly, or when its state changes (eg. render target, scale),
+/// to keep the drawing order. If SDL_RenderGeometry is not available,
+/// the quads are copied immediately.
+class SDLSpriteBatch {
+public:
+    SDLSpriteBatch(SDL_Renderer*);
+
+    /// Add a quad; `src` is the region of the texture, in pixels
+    void add(SDL_Texture*, int tex_w, int tex_h, const SDL_Rect& src, const SDL_Rect& dst, const SDL_Color&);
+    /// Submit the collected quads
+    void flush();
+    /// Flush the batch if it contains the texture, eg. before destroying it
+    void release(SDL_Texture*);
+
+private:
+    SDL_Renderer* const renderer;
+    SDL_Texture* current_texture;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+#endif
+};
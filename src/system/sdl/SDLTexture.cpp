@@ -1,35 +1,53 @@
 #include "SDLTexture.h"
 
+#include "SDLSpriteBatch.h"
+
 #include <assert.h>
 
 
 SDL2pp::Renderer* SDLTexture::renderer = nullptr;
+SDLSpriteBatch* SDLTexture::batch = nullptr;
 
 SDLTexture::SDLTexture(SDL2pp::Texture&& tex)
     : tex(std::move(tex))
-{}
+    , tex_width(this->tex.GetWidth())
+    , tex_height(this->tex.GetHeight())
+{
+    SDL_GetTextureColorMod(this->tex.Get(), &modulation.r, &modulation.g, &modulation.b);
+    SDL_GetTextureAlphaMod(this->tex.Get(), &modulation.a);
+}
 
-void SDLTexture::drawAt(int x, int y)
+SDLTexture::~SDLTexture()
+{
+    // the texture may still be used by the quads waiting for submission
+    if (batch)
+        batch->release(tex.Get());
+}
+
+void SDLTexture::draw(const SDL_Rect& from, const SDL_Rect& to)
 {
     assert(renderer);
-    renderer->Copy(tex, SDL2pp::NullOpt, SDL2pp::Point(x, y));
+    assert(batch);
+    batch->add(tex.Get(), tex_width, tex_height, from, to, modulation);
+}
+
+void SDLTexture::drawAt(int x, int y)
+{
+    draw({0, 0, tex_width, tex_height}, {x, y, tex_width, tex_height});
 }
 
 void SDLTexture::drawScaled(const Rectangle& rect)
 {
-    assert(renderer);
-    renderer->Copy(tex, SDL2pp::NullOpt, SDL2pp::Rect(rect.x, rect.y, rect.w, rect.h));
+    draw({0, 0, tex_width, tex_height}, {rect.x, rect.y, rect.w, rect.h});
 }
 
 void SDLTexture::drawPartialScaled(const Rectangle& from, const Rectangle& to)
 {
-    assert(renderer);
-    renderer->Copy(tex,
-                   SDL2pp::Rect(from.x, from.y, from.w, from.h),
-                   SDL2pp::Rect(to.x, to.y, to.w, to.h));
+    draw({from.x, from.y, from.w, from.h}, {to.x, to.y, to.w, to.h});
 }
 
 void SDLTexture::setAlpha(uint8_t alpha)
 {
     tex.SetAlphaMod(alpha);
+    modulation.a = alpha;
 }
@@ -4,24 +4,34 @@
 
 #include <SDL2pp/SDL2pp.hh>
 
+class SDLSpriteBatch;
+
 
 class SDLTexture : public Texture {
 public:
     SDLTexture(SDL2pp::Texture&&);
+    ~SDLTexture();
 
     void drawAt(int x, int y) final;
     void drawScaled(const Rectangle&) final;
     void drawPartialScaled(const Rectangle& from, const Rectangle& to) final;
 
     void setAlpha(uint8_t) final;
-    uint8_t alpha() const final { return tex.GetAlphaMod(); }
+    uint8_t alpha() const final { return modulation.a; }
 
-    unsigned width() const final { return tex.GetWidth(); }
-    unsigned height() const final { return tex.GetHeight(); }
+    unsigned width() const final { return tex_width; }
+    unsigned height() const final { return tex_height; }
 
 private:
     static SDL2pp::Renderer* renderer;
+    static SDLSpriteBatch* batch;
     SDL2pp::Texture tex;
+    // cached, to avoid querying the texture on every draw
+    const int tex_width;
+    const int tex_height;
+    SDL_Color modulation;
+
+    void draw(const SDL_Rect& from, const SDL_Rect& to);
 
 friend class SDLGraphicsContext;
 };
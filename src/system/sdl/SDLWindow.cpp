@@ -10,12 +10,25 @@
 
 const std::string LOG_INPUT_TAG = "input";
 
-SDLWindow::SDLWindow()
-    : sdl(SDL_INIT_VIDEO | SDL_INIT_GAMECONTROLLER)
+/// Selects the drivers, then returns the subsystems to initialize;
+/// the drivers have to be chosen before SDL is initialized.
+static Uint32 prepareSDL(bool headless)
+{
+    if (headless) {
+        // the dummy video driver draws into an in-memory framebuffer
+        SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+        SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    }
+    return SDL_INIT_VIDEO | SDL_INIT_GAMECONTROLLER;
+}
+
+SDLWindow::SDLWindow(int width, int height, bool headless)
+    : sdl(prepareSDL(headless))
     , window(std::string("OpenBlok ") + game_version,
         SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
-        960, 540,
-        SDL_WINDOW_RESIZABLE)
+        width, height,
+        headless ? SDL_WINDOW_HIDDEN : SDL_WINDOW_RESIZABLE)
     , gcx(window)
     , default_keyboard_mapping({
             {SDL_SCANCODE_P, {InputType::GAME_PAUSE}},
@@ -83,9 +96,32 @@ void SDLWindow::toggleFullscreen()
     window.SetFullscreen(window.GetFlags() ^ SDL_WINDOW_FULLSCREEN_DESKTOP);
 }
 
+unsigned SDLWindow::refreshRate() const
+{
+    SDL_DisplayMode mode;
+    if (SDL_GetWindowDisplayMode(window.Get(), &mode) != 0 || mode.refresh_rate < 0)
+        return 0;
+    return mode.refresh_rate;
+}
+
 void SDLWindow::requestScreenshot(const std::string& path)
 {
-    gcx.requestScreenshot(window, path);
+    gcx.frameCapture().requestScreenshot(path);
+}
+
+void SDLWindow::startRecording(const std::string& path)
+{
+    gcx.frameCapture().startRecording(path);
+}
+
+void SDLWindow::stopRecording()
+{
+    gcx.frameCapture().stopRecording();
+}
+
+void SDLWindow::waitForCaptures()
+{
+    gcx.frameCapture().flush();
 }
 
 void SDLWindow::setInputConfig(const std::map<DeviceName, DeviceData>& known)
@@ -151,7 +187,7 @@ ButtonToEventsMap SDLWindow::knownButtonmapForDeviceName(const std::string& devi
     return known_mappings.at(device_name).buttonmap;
 }
 
-std::vector<Event> SDLWindow::collectEvents()
+void SDLWindow::collectEvents(std::vector<Event>& output)
 {
     /* Note: because the SDL2 GameController API builds on top the SDL Joystick API,
      * game controllers can also receive joaystick events.
@@ -163,7 +199,7 @@ std::vector<Event> SDLWindow::collectEvents()
     static const short int AXIS_MAX = 32767;
     static const short int AXIS_MIN = -32768;
 
-    std::vector<Event> output;
+    output.clear();
 
     SDL_Event sdl_event;
     while (SDL_PollEvent(&sdl_event)) {
@@ -182,6 +218,9 @@ std::vector<Event> SDLWindow::collectEvents()
                 case SDL_WINDOWEVENT_FOCUS_GAINED:
                     output.emplace_back(WindowEvent::FOCUS_GAINED);
                     break;
+                case SDL_WINDOWEVENT_EXPOSED:
+                    output.emplace_back(WindowEvent::EXPOSED);
+                    break;
                 case SDL_WINDOWEVENT_RESIZED:
                     gcx.onResize(sdl_event.window.data1, sdl_event.window.data2);
                     output.emplace_back(WindowEvent::RESIZED);
@@ -190,6 +229,11 @@ std::vector<Event> SDLWindow::collectEvents()
                     break;
             }
             break;
+        case SDL_RENDER_TARGETS_RESET:
+        case SDL_RENDER_DEVICE_RESET:
+            gcx.onRenderTargetsReset();
+            output.emplace_back(WindowEvent::EXPOSED);
+            break;
         case SDL_CONTROLLERDEVICEADDED:
             // Note: It seems this event doesn't always trigger,
             // so the code was moved to SDL_JOYDEVICEADDED, which happens
@@ -393,8 +437,6 @@ std::vector<Event> SDLWindow::collectEvents()
             break;
         }
     }
-
-    return output;
 }
 
 void SDLWindow::showErrorMessage(const std::string& title, const std::string& content)
@@ -14,14 +14,18 @@
 
 class SDLWindow : public Window {
 public:
-    SDLWindow();
+    SDLWindow(int width, int height, bool headless);
 
     void toggleFullscreen() final;
+    unsigned refreshRate() const final;
     void requestScreenshot(const std::string&) final;
+    void startRecording(const std::string&) final;
+    void stopRecording() final;
+    void waitForCaptures() final;
     GraphicsContext& graphicsContext() final { return gcx; };
     AudioContext& audioContext() final { return audio; };
 
-    std::vector<Event> collectEvents() final;
+    void collectEvents(std::vector<Event>&) final;
     bool quitRequested() final { return m_quit_requested; }
 
     void setInputConfig(const std::map<DeviceName, DeviceData>&) final;
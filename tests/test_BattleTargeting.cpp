@@ -0,0 +1,71 @@
+#include "UnitTest++/UnitTest++.h"
+
+#include "game/BattleTargeting.h"
+
+#include <vector>
+
+
+SUITE(BattleTargeting) {
+
+TEST(RandomTargetsAreOpponents)
+{
+    // two teams of 32 players
+    std::vector<size_t> teams(64);
+    for (size_t slot = 0; slot < teams.size(); slot++)
+        teams[slot] = slot % 2;
+
+    BattleTargeting targeting(TargetingType::RANDOM, teams, 1);
+    for (unsigned i = 0; i < 1000; i++) {
+        const size_t attacker = i % teams.size();
+        const size_t target = targeting.selectTarget(attacker);
+        REQUIRE CHECK(target < teams.size());
+        CHECK(teams[target] != teams[attacker]);
+    }
+}
+
+TEST(RemovedPlayersAreNotTargeted)
+{
+    BattleTargeting targeting(TargetingType::RANDOM, {0, 1, 2, 3}, 1);
+    targeting.removePlayer(1);
+    targeting.removePlayer(2);
+    targeting.removePlayer(2);
+    CHECK_EQUAL(2u, targeting.playingCount());
+    CHECK(!targeting.isPlaying(1));
+
+    for (unsigned i = 0; i < 100; i++)
+        CHECK_EQUAL(3u, targeting.selectTarget(0));
+
+    targeting.removePlayer(3);
+    CHECK_EQUAL(BattleTargeting::no_target, targeting.selectTarget(0));
+}
+
+TEST(Attackers)
+{
+    BattleTargeting targeting(TargetingType::ATTACKERS, {0, 1, 2, 3, 4, 5, 6, 7}, 1);
+    const size_t target = targeting.selectTarget(5);
+    CHECK_EQUAL(5u, targeting.selectTarget(target));
+    CHECK_EQUAL(target, targeting.selectTarget(5));
+
+    // the attacker is knocked out, so a new target is needed
+    targeting.removePlayer(5);
+    const size_t new_target = targeting.selectTarget(target);
+    CHECK(new_target != 5u);
+    CHECK(new_target != target);
+}
+
+TEST(KOFocused)
+{
+    BattleTargeting targeting(TargetingType::KO_FOCUSED, {0, 1, 2, 3, 4, 5, 6, 7}, 1);
+    const size_t focus = targeting.selectTarget(0);
+    for (size_t attacker = 1; attacker < 8; attacker++) {
+        if (attacker != focus)
+            CHECK_EQUAL(focus, targeting.selectTarget(attacker));
+    }
+
+    targeting.removePlayer(focus);
+    const size_t new_focus = targeting.selectTarget(0);
+    CHECK(new_focus != focus);
+    CHECK(targeting.isPlaying(new_focus));
+}
+
+} // Suite
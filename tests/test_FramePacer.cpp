@@ -0,0 +1,96 @@
+#include "UnitTest++/UnitTest++.h"
+
+#include "game/FramePacer.h"
+
+#include <chrono>
+#include <thread>
+
+
+SUITE(FramePacer) {
+
+TEST(Stats)
+{
+    using std::chrono::milliseconds;
+
+    FramePacer::Stats stats;
+    stats.add(milliseconds(16), milliseconds(16));
+    stats.add(milliseconds(18), milliseconds(16));
+    stats.add(milliseconds(14), milliseconds(16));
+    stats.add(milliseconds(32), milliseconds(16));
+
+    CHECK_EQUAL(4u, stats.count);
+    CHECK(milliseconds(20) == std::chrono::duration_cast<milliseconds>(stats.mean));
+    CHECK(milliseconds(32) == stats.max);
+    CHECK_EQUAL(1u, stats.late_frames);
+    // the sample standard deviation of 16, 18, 14, 32 is ~8.16 ms
+    const auto jitter_us = std::chrono::duration_cast<std::chrono::microseconds>(stats.jitter).count();
+    CHECK_CLOSE(8165, jitter_us, 2);
+
+    stats.addAllocations(0);
+    stats.addAllocations(3);
+    stats.addAllocations(1);
+    CHECK_EQUAL(2u, stats.allocating_frames);
+    CHECK_EQUAL(3u, stats.max_allocations);
+}
+
+TEST(TimerPacing)
+{
+    const Duration interval = std::chrono::milliseconds(2);
+    FramePacer pacer(FramePacing::TIMER, interval);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < 10; i++) {
+        pacer.waitForNextFrame();
+        pacer.markSubmit();
+        pacer.markPresent();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    CHECK(elapsed >= interval * 10);
+    CHECK_EQUAL(9u, pacer.stats().count); // the first present has no previous one
+    const auto mean_us = std::chrono::duration_cast<std::chrono::microseconds>(pacer.stats().mean).count();
+    CHECK_CLOSE(2000, mean_us, 500);
+}
+
+TEST(TimerPacingDoesNotDrift)
+{
+    const Duration interval = std::chrono::milliseconds(5);
+    FramePacer pacer(FramePacing::TIMER, interval);
+
+    // the work of every frame is less than the interval,
+    // so it shouldn't delay the following frames
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < 20; i++) {
+        pacer.waitForNextFrame();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        pacer.markSubmit();
+        pacer.markPresent();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    CHECK(elapsed >= interval * 20);
+    CHECK(elapsed < interval * 25);
+}
+
+TEST(IdleFrameAfterShortFrames)
+{
+    const Duration interval = std::chrono::milliseconds(10);
+    FramePacer pacer(FramePacing::VSYNC, interval);
+
+    // without a display blocking the presents, the vsync frames are shorter than the interval
+    for (unsigned i = 0; i < 40; i++) {
+        pacer.waitForNextFrame();
+        pacer.markSubmit();
+        pacer.markPresent();
+    }
+
+    // a frame that presents nothing, then the wait for the next frame
+    pacer.waitForNextFrame();
+    const auto start = std::chrono::steady_clock::now();
+    pacer.waitForNextFrame();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    CHECK(elapsed < interval * 3);
+}
+
+} // Suite
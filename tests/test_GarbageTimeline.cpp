@@ -0,0 +1,69 @@
+#include "UnitTest++/UnitTest++.h"
+
+#include "game/GarbageTimeline.h"
+
+#include <array>
+
+
+SUITE(GarbageTimeline) {
+
+TEST(ArrivalOrder)
+{
+    GarbageTimeline timeline;
+    timeline.push(1, 2, 10, 3);
+    timeline.push(2, 1, 20, 7);
+    CHECK_EQUAL(3u, timeline.totalLines());
+
+    std::array<uint16_t, 40> rows;
+    CHECK_EQUAL(0u, timeline.popArrived(9, 10, rows.data(), rows.size()));
+
+    REQUIRE CHECK_EQUAL(2u, timeline.popArrived(15, 10, rows.data(), rows.size()));
+    CHECK_EQUAL(0x3FF & ~(1 << 3), rows[0]);
+    CHECK_EQUAL(0x3FF & ~(1 << 3), rows[1]);
+    CHECK_EQUAL(1u, timeline.totalLines());
+
+    REQUIRE CHECK_EQUAL(1u, timeline.popArrived(20, 10, rows.data(), rows.size()));
+    CHECK_EQUAL(0x3FF & ~(1 << 7), rows[0]);
+    CHECK_EQUAL(0u, timeline.size());
+    CHECK_EQUAL(0u, timeline.totalLines());
+}
+
+TEST(PartialCancel)
+{
+    GarbageTimeline timeline;
+    timeline.push(1, 4, 10, 0);
+    timeline.push(2, 3, 12, 0);
+
+    CHECK_EQUAL(5u, timeline.cancel(5));
+    REQUIRE CHECK_EQUAL(1u, timeline.size());
+    CHECK_EQUAL(2u, timeline.at(0).lines);
+    CHECK_EQUAL(2u, timeline.at(0).attacker);
+
+    CHECK_EQUAL(2u, timeline.cancel(10));
+    CHECK_EQUAL(0u, timeline.size());
+    CHECK_EQUAL(0u, timeline.totalLines());
+}
+
+TEST(FullRingMergesLines)
+{
+    GarbageTimeline timeline;
+    for (unsigned i = 0; i < GarbageTimeline::capacity + 2; i++)
+        timeline.push(0, 1, i, 0);
+
+    CHECK_EQUAL(GarbageTimeline::capacity, timeline.size());
+    CHECK_EQUAL(GarbageTimeline::capacity + 2, timeline.totalLines());
+    CHECK_EQUAL(3u, timeline.at(GarbageTimeline::capacity - 1).lines);
+}
+
+TEST(RowsAreLimited)
+{
+    GarbageTimeline timeline;
+    timeline.push(0, 30, 0, 0);
+    timeline.push(0, 30, 0, 1);
+
+    std::array<uint16_t, 40> rows;
+    CHECK_EQUAL(40u, timeline.popArrived(0, 10, rows.data(), rows.size()));
+    CHECK_EQUAL(0u, timeline.totalLines());
+}
+
+} // Suite
@@ -6,13 +6,16 @@
 #include "system/GraphicsContext.h"
 #include "system/Texture.h"
 
+#include <fstream>
 
-class AppContext {
+
+class HeadlessWindow {
 public:
-    AppContext()
-        : window(Window::create())
+    HeadlessWindow()
+        : window(Window::createHeadless(640, 480))
     {
-        // TODO: set window and resolution to 640x480
+        // the references were drawn without scaling
+        gcx().modifyDrawScale(1.0);
     }
 
     GraphicsContext& gcx() {
@@ -26,16 +29,17 @@ protected:
 
 SUITE(GraphicsContext) {
 
-TEST_FIXTURE(AppContext, Create) {
+TEST_FIXTURE(HeadlessWindow, Create) {
     // do nothing
 }
 
-TEST_FIXTURE(AppContext, SaveScreenshot) {
+TEST_FIXTURE(HeadlessWindow, SaveScreenshot) {
     window->requestScreenshot(std::tmpnam(nullptr));
     gcx().render();
+    window->waitForCaptures();
 }
 
-TEST_FIXTURE(AppContext, TextRendering) {
+TEST_FIXTURE(HeadlessWindow, TextRendering) {
     auto font = gcx().loadFont("data/fonts/PTC75F.ttf", 20);
 
     // The regular font must support all english characters
@@ -58,11 +62,12 @@ TEST_FIXTURE(AppContext, TextRendering) {
     const std::string screenshot_path = std::tmpnam(nullptr);
     window->requestScreenshot(screenshot_path);
     gcx().render();
+    window->waitForCaptures();
 
     CHECK(TestUtils::imageCompare("tests/references/text_multilang.png", screenshot_path));
 }
 
-TEST_FIXTURE(AppContext, TextLinebreak) {
+TEST_FIXTURE(HeadlessWindow, TextLinebreak) {
     auto font = gcx().loadFont("data/fonts/PTC75F.ttf", 30);
     auto tex = font->renderText("There should be\nthree lines\non the screen", 0xFFFFFF_rgb);
 
@@ -71,11 +76,12 @@ TEST_FIXTURE(AppContext, TextLinebreak) {
     const std::string screenshot_path = std::tmpnam(nullptr);
     window->requestScreenshot(screenshot_path);
     gcx().render();
+    window->waitForCaptures();
 
     CHECK(TestUtils::imageCompare("tests/references/text_multiline.png", screenshot_path));
 }
 
-TEST_FIXTURE(AppContext, TextEmpty) {
+TEST_FIXTURE(HeadlessWindow, TextEmpty) {
     auto font = gcx().loadFont("data/fonts/PTC75F.ttf", 30);
 
     CHECK_THROW(
@@ -84,7 +90,7 @@ TEST_FIXTURE(AppContext, TextEmpty) {
     );
 }
 
-TEST_FIXTURE(AppContext, DrawRect) {
+TEST_FIXTURE(HeadlessWindow, DrawRect) {
     gcx().drawFilledRect({10, 20, 120, 100}, 0xFF0000_rgb);
     gcx().drawFilledRect({50, 60, 120, 100}, 0x00FF00_rgb);
     gcx().drawFilledRect({100, 110, 120, 100}, 0x0000FF_rgb);
@@ -92,31 +98,49 @@ TEST_FIXTURE(AppContext, DrawRect) {
     const std::string screenshot_path = std::tmpnam(nullptr);
     window->requestScreenshot(screenshot_path);
     gcx().render();
+    window->waitForCaptures();
 
     CHECK(TestUtils::imageCompare("tests/references/draw_filledrect.png", screenshot_path));
 }
 
-TEST_FIXTURE(AppContext, LoadImage) {
+TEST_FIXTURE(HeadlessWindow, LoadImage) {
     auto tex = gcx().loadTexture("tests/data/green_rect.png");
     tex->drawAt(10, 10);
 
     const std::string screenshot_path = std::tmpnam(nullptr);
     window->requestScreenshot(screenshot_path);
     gcx().render();
-
+    window->waitForCaptures();
 
     CHECK(TestUtils::imageCompare("tests/references/draw_image.png", screenshot_path));
 }
 
-TEST_FIXTURE(AppContext, DrawScaled) {
+TEST_FIXTURE(HeadlessWindow, DrawScaled) {
     auto tex = gcx().loadTexture("tests/data/green_rect.png");
     tex->drawScaled({10, 20, 50, 50});
 
     const std::string screenshot_path = std::tmpnam(nullptr);
     window->requestScreenshot(screenshot_path);
     gcx().render();
+    window->waitForCaptures();
 
     CHECK(TestUtils::imageCompare("tests/references/draw_scaled.png", screenshot_path));
 }
 
+TEST_FIXTURE(HeadlessWindow, RecordVideo) {
+    const std::string video_path = std::tmpnam(nullptr);
+    window->startRecording(video_path);
+    for (unsigned i = 0; i < 3; i++) {
+        gcx().drawFilledRect({10, 20, 120, 100}, 0xFF0000_rgb);
+        gcx().render();
+    }
+    window->stopRecording();
+    window->waitForCaptures();
+
+    std::ifstream file(video_path, std::ios::binary);
+    std::string header;
+    std::getline(file, header);
+    CHECK_EQUAL("YUV4MPEG2 W640 H480 F60:1 Ip A1:1 C420jpeg XCOLORRANGE=FULL", header);
+}
+
 } // SUITE
@@ -0,0 +1,68 @@
+#include "UnitTest++/UnitTest++.h"
+
+#include "game/components/MinoStorage.h"
+#include "game/components/NextQueue.h"
+#include "game/components/PieceFactory.h"
+#include "game/components/rotations/SRS.h"
+
+#include <set>
+#include <vector>
+
+
+SUITE(NextQueue) {
+
+struct NextQueueFixture {
+    NextQueueFixture() {
+        MinoStorage::loadDummyMinos();
+        PieceFactory::changeInitialPositions(Rotations::SRS().initialPositions());
+    }
+};
+
+TEST_FIXTURE(NextQueueFixture, SevenBag)
+{
+    NextQueue queue(5);
+    for (unsigned bag = 0; bag < 1000; bag++) {
+        std::set<PieceType> pieces;
+        for (unsigned i = 0; i < PieceTypeList.size(); i++)
+            pieces.insert(queue.next());
+        CHECK_EQUAL(PieceTypeList.size(), pieces.size());
+    }
+}
+
+TEST_FIXTURE(NextQueueFixture, SameOrderForAllPlayers)
+{
+    NextQueue queue_a(5);
+    NextQueue queue_b(1);
+
+    // the players can be at different positions in the sequence
+    for (unsigned i = 0; i < 10; i++)
+        queue_a.next();
+
+    std::vector<PieceType> pieces_a;
+    for (unsigned i = 0; i < 100; i++)
+        pieces_a.push_back(queue_a.next());
+
+    for (unsigned i = 0; i < 10; i++)
+        queue_b.next();
+    for (unsigned i = 0; i < 100; i++) {
+        CHECK(queue_b.preview(0) == pieces_a.at(i));
+        CHECK(queue_b.next() == pieces_a.at(i));
+    }
+}
+
+TEST_FIXTURE(NextQueueFixture, PreviewCount)
+{
+    NextQueue queue(1);
+    queue.setPreviewCount(5);
+    CHECK_EQUAL(5u, queue.previewCount());
+
+    const PieceType fifth = queue.preview(4);
+    for (unsigned i = 0; i < 4; i++)
+        queue.next();
+    CHECK(queue.preview(0) == fifth);
+
+    queue.setPreviewCount(100);
+    CHECK_EQUAL(NextQueue::max_preview_count, queue.previewCount());
+}
+
+} // Suite
@@ -0,0 +1,108 @@
+#include "UnitTest++/UnitTest++.h"
+
+#include "game/bot/PerfectClearSolver.h"
+#include "game/components/HoldQueue.h"
+#include "game/components/MinoStorage.h"
+#include "game/components/NextQueue.h"
+#include "game/components/PieceFactory.h"
+#include "game/components/Well.h"
+#include "game/components/rotations/SRS.h"
+
+#include <string>
+#include <vector>
+
+
+SUITE(PerfectClearSolver) {
+
+struct SolverFixture {
+    SolverFixture() {
+        MinoStorage::loadDummyMinos();
+        PieceFactory::changeInitialPositions(Rotations::SRS().initialPositions());
+    }
+};
+
+TEST_FIXTURE(SolverFixture, SingleLine)
+{
+    Bot::PerfectClearSolver solver;
+    const auto result = solver.solve({0x3F0}, {PieceType::I}, false, PieceType::I);
+
+    REQUIRE CHECK(result.found);
+    CHECK_EQUAL(1u, result.lines);
+    REQUIRE CHECK_EQUAL(1u, result.steps.size());
+    CHECK(result.steps.front().type == PieceType::I);
+    CHECK(result.steps.front().direction == PieceDirection::NORTH);
+    CHECK_EQUAL(0, result.steps.front().x);
+    CHECK(!result.steps.front().uses_hold);
+}
+
+TEST_FIXTURE(SolverFixture, UsesHold)
+{
+    Bot::PerfectClearSolver solver;
+    const auto result = solver.solve({0x3F0}, {PieceType::O}, true, PieceType::I);
+
+    REQUIRE CHECK(result.found);
+    REQUIRE CHECK_EQUAL(1u, result.steps.size());
+    CHECK(result.steps.front().type == PieceType::I);
+    CHECK(result.steps.front().uses_hold);
+}
+
+TEST_FIXTURE(SolverFixture, EmptyBoard)
+{
+    Bot::PerfectClearSolver::Settings settings;
+    settings.time_limit = std::chrono::seconds(5);
+    Bot::PerfectClearSolver solver(settings);
+
+    const std::vector<PieceType> pieces(10, PieceType::I);
+    const auto result = solver.solve({}, pieces, false, PieceType::I);
+
+    REQUIRE CHECK(result.found);
+    CHECK_EQUAL(4u, result.lines);
+    CHECK_EQUAL(10u, result.steps.size());
+}
+
+TEST_FIXTURE(SolverFixture, Impossible)
+{
+    Bot::PerfectClearSolver solver;
+    const auto result = solver.solve({0x3FE}, {PieceType::O, PieceType::O}, false, PieceType::I);
+
+    CHECK(!result.found);
+    CHECK(!result.timed_out);
+}
+
+TEST_FIXTURE(SolverFixture, TooHigh)
+{
+    Bot::PerfectClearSolver solver;
+    const auto result = solver.solve({0x3F0, 0, 0, 0, 0x1}, {PieceType::I}, false, PieceType::I);
+
+    CHECK(!result.found);
+    CHECK_EQUAL(0u, result.searched_nodes);
+}
+
+TEST_FIXTURE(SolverFixture, FromWell)
+{
+    std::string emptyline_ascii;
+    for (unsigned i = 0; i < 10; i++)
+        emptyline_ascii += '.';
+    emptyline_ascii += '\n';
+
+    std::string board_ascii;
+    for (unsigned i = 0; i < 21; i++)
+        board_ascii += emptyline_ascii;
+    board_ascii += "SSZZTT....\n";
+
+    Well well;
+    well.fromAscii(board_ascii);
+    well.addPiece(PieceType::I);
+    NextQueue next_queue;
+    HoldQueue hold_queue;
+
+    Bot::PerfectClearSolver solver;
+    const auto result = solver.solve(well, next_queue, hold_queue);
+
+    REQUIRE CHECK(result.found);
+    REQUIRE CHECK_EQUAL(1u, result.steps.size());
+    CHECK(result.steps.front().type == PieceType::I);
+    CHECK_EQUAL(6, result.steps.front().x);
+}
+
+} // Suite
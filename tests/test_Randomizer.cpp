@@ -0,0 +1,119 @@
+#include "UnitTest++/UnitTest++.h"
+
+#include "game/components/randomizers/Randomizer.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+
+SUITE(Randomizer) {
+
+template <typename Policy>
+std::vector<PieceType> generate(unsigned count, uint64_t seed = 42)
+{
+    Randomizers::Generator<Policy> generator(seed);
+    std::vector<PieceType> pieces;
+    for (unsigned i = 0; i < count; i++)
+        pieces.push_back(generator.next());
+    return pieces;
+}
+
+std::array<unsigned, 7> countPieces(std::vector<PieceType>::const_iterator begin,
+                                    std::vector<PieceType>::const_iterator end)
+{
+    std::array<unsigned, 7> counts = {};
+    for (auto it = begin; it != end; ++it)
+        counts.at(static_cast<size_t>(*it))++;
+    return counts;
+}
+
+// Pearson's chi-squared statistic against the uniform distribution
+double chiSquared(const std::vector<PieceType>& pieces)
+{
+    const auto counts = countPieces(pieces.cbegin(), pieces.cend());
+    const double expected = pieces.size() / 7.0;
+    double result = 0.0;
+    for (const unsigned count : counts)
+        result += (count - expected) * (count - expected) / expected;
+    return result;
+}
+
+// the critical value for 6 degrees of freedom at p = 0.001
+const double chi_squared_limit = 22.46;
+
+TEST(Bag7)
+{
+    const auto pieces = generate<Randomizers::Bag7>(7 * 1000);
+    for (size_t i = 0; i < pieces.size(); i += 7) {
+        const auto counts = countPieces(pieces.cbegin() + i, pieces.cbegin() + i + 7);
+        CHECK(std::all_of(counts.begin(), counts.end(), [](unsigned c){ return c == 1; }));
+    }
+}
+
+TEST(Bag14)
+{
+    const auto pieces = generate<Randomizers::Bag14>(14 * 1000);
+    for (size_t i = 0; i < pieces.size(); i += 14) {
+        const auto counts = countPieces(pieces.cbegin() + i, pieces.cbegin() + i + 14);
+        CHECK(std::all_of(counts.begin(), counts.end(), [](unsigned c){ return c == 2; }));
+    }
+}
+
+TEST(Bag7Plus1)
+{
+    const auto pieces = generate<Randomizers::Bag7Plus1>(8 * 1000);
+    for (size_t i = 0; i < pieces.size(); i += 8) {
+        const auto counts = countPieces(pieces.cbegin() + i, pieces.cbegin() + i + 8);
+        CHECK(std::all_of(counts.begin(), counts.end(), [](unsigned c){ return c >= 1; }));
+    }
+    CHECK(chiSquared(pieces) < chi_squared_limit);
+}
+
+TEST(PureRandom)
+{
+    const auto pieces = generate<Randomizers::PureRandom>(70000);
+    CHECK(chiSquared(pieces) < chi_squared_limit);
+
+    // unlike bags, the same piece can come many times in a row
+    unsigned repeats = 0;
+    for (size_t i = 1; i < pieces.size(); i++)
+        repeats += pieces[i] == pieces[i - 1];
+    CHECK_CLOSE(1.0 / 7, static_cast<double>(repeats) / pieces.size(), 0.01);
+}
+
+TEST(TGMHistory)
+{
+    for (uint64_t seed = 0; seed < 100; seed++) {
+        const PieceType first = generate<Randomizers::TGMHistory>(1, seed).front();
+        CHECK(first != PieceType::S && first != PieceType::Z && first != PieceType::O);
+    }
+
+    const auto pieces = generate<Randomizers::TGMHistory>(70000);
+    CHECK(chiSquared(pieces) < chi_squared_limit);
+
+    // a piece in the last 4 only comes if every reroll failed
+    unsigned recent = 0;
+    for (size_t i = 4; i < pieces.size(); i++)
+        recent += std::find(pieces.begin() + i - 4, pieces.begin() + i, pieces[i]) != pieces.begin() + i;
+    CHECK(static_cast<double>(recent) / pieces.size() < 0.1);
+}
+
+TEST(SameSeedSameSequence)
+{
+    CHECK(generate<Randomizers::TGMHistory>(1000, 7) == generate<Randomizers::TGMHistory>(1000, 7));
+    CHECK(generate<Randomizers::Bag7>(1000, 7) != generate<Randomizers::Bag7>(1000, 8));
+
+    // the runtime selected randomizers produce the same pieces as the generators
+    const auto expected = generate<Randomizers::Bag14>(14 * 10, 7);
+    auto randomizer = RandomizerFactory::make(RandomizerType::BAG14, 7);
+    std::vector<PieceType> pieces;
+    std::array<PieceType, Randomizers::max_block_size> block;
+    while (pieces.size() < expected.size()) {
+        const unsigned count = randomizer->nextBlock(block.data());
+        pieces.insert(pieces.end(), block.begin(), block.begin() + count);
+    }
+    CHECK(pieces == expected);
+}
+
+} // Suite
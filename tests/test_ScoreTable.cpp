@@ -0,0 +1,73 @@
+#include "UnitTest++/UnitTest++.h"
+
+#include "game/GameConfigFile.h"
+#include "game/PlayerStatistics.h"
+#include "game/ScoreTable.h"
+
+#include <cstdio>
+
+
+SUITE(ScoreTable) {
+
+TEST(GuidelineRules)
+{
+    const ScoreRules& rules = ScoreTable::rules(ScoreRuleSet::GUIDELINE);
+
+    WellEvent::lineclear_t lineclear;
+    lineclear.type = LineClearType::TSPIN;
+    lineclear.count = 2;
+    const ScoreType type = ScoreTable::lineclearType(lineclear);
+    CHECK(type == ScoreType::CLEAR_TSPIN_DOUBLE);
+    CHECK_EQUAL(1200, rules.value(type));
+    CHECK_EQUAL(12, rules.lineAwards(type));
+    CHECK_EQUAL(4u, rules.sendableLineCount(type, false));
+    CHECK_EQUAL(5u, rules.sendableLineCount(type, true));
+
+    CHECK(rules.canContinueBackToBack(ScoreType::CLEAR_PERFECT, ScoreType::CLEAR_TSPIN_SINGLE));
+    CHECK(!rules.canContinueBackToBack(ScoreType::CLEAR_PERFECT, ScoreType::CLEAR_TRIPLE));
+    CHECK_EQUAL(0u, rules.sendableLineCount(ScoreType::CLEAR_SINGLE, false));
+}
+
+TEST(ClassicRules)
+{
+    const ScoreRules& rules = ScoreTable::rules(ScoreRuleSet::CLASSIC);
+
+    CHECK_EQUAL(1200, rules.value(ScoreType::CLEAR_PERFECT));
+    CHECK_EQUAL(4, rules.lineAwards(ScoreType::CLEAR_PERFECT));
+    CHECK(!rules.canContinueBackToBack(ScoreType::CLEAR_PERFECT, ScoreType::CLEAR_PERFECT));
+    CHECK_EQUAL(0, rules.value(ScoreType::COMBO));
+}
+
+TEST(CustomRulesConfig)
+{
+    SysConfig sys;
+    WellConfig well;
+    CHECK_EQUAL(800, well.custom_score_rules.value(ScoreType::CLEAR_PERFECT));
+
+    well.score_rules = ScoreRuleSet::CUSTOM;
+    well.custom_score_rules.score[ScoreType::CLEAR_PERFECT] = 2000;
+    well.custom_score_rules.attack_lines[ScoreType::CLEAR_TSPIN_DOUBLE] = 7;
+    well.custom_score_rules.continues_back2back[ScoreType::CLEAR_TRIPLE] = true;
+
+    const std::string path = std::tmpnam(nullptr);
+    GameConfigFile::save(sys, well, path);
+    const WellConfig loaded = std::get<1>(GameConfigFile::load(path));
+    std::remove(path.c_str());
+
+    CHECK(loaded.score_rules == ScoreRuleSet::CUSTOM);
+    CHECK_EQUAL(2000, loaded.custom_score_rules.value(ScoreType::CLEAR_PERFECT));
+    CHECK_EQUAL(7u, loaded.custom_score_rules.sendableLineCount(ScoreType::CLEAR_TSPIN_DOUBLE, false));
+    CHECK(loaded.custom_score_rules.canContinueBackToBack(ScoreType::CLEAR_TRIPLE, ScoreType::CLEAR_PERFECT));
+    CHECK_EQUAL(12, loaded.custom_score_rules.lineAwards(ScoreType::CLEAR_TSPIN_DOUBLE));
+}
+
+TEST(EventCounters)
+{
+    PlayerStatistics stats;
+    CHECK_EQUAL(0, stats.event_count[ScoreType::CLEAR_DOUBLE]);
+    stats.event_count[ScoreType::CLEAR_DOUBLE]++;
+    CHECK_EQUAL(1, stats.event_count[ScoreType::CLEAR_DOUBLE]);
+    CHECK_EQUAL(0, stats.event_count[ScoreType::CLEAR_SINGLE]);
+}
+
+} // Suite
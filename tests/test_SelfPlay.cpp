@@ -0,0 +1,95 @@
+#include "UnitTest++/UnitTest++.h"
+
+#include "game/bot/Board.h"
+#include "game/bot/DatasetWriter.h"
+#include "game/bot/SelfPlay.h"
+#include "game/components/PieceFactory.h"
+#include "game/components/rotations/SRS.h"
+#include "game/util/PackBits.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+
+SUITE(SelfPlay) {
+
+struct SelfPlayFixture {
+    SelfPlayFixture() {
+        PieceFactory::changeInitialPositions(Rotations::SRS().initialPositions());
+    }
+};
+
+TEST_FIXTURE(SelfPlayFixture, BoardPlacement)
+{
+    Bot::PieceShapes shapes;
+    Bot::Board board;
+    board.addGarbageLines(1, 9);
+
+    unsigned placement_count = 0;
+    Bot::Placement vertical_i = {};
+    board.forEachPlacement(shapes, PieceType::I, false, [&](const Bot::Placement& placement){
+        placement_count++;
+        if (placement.direction == PieceDirection::EAST && placement.x == 7)
+            vertical_i = placement;
+    });
+    CHECK_EQUAL(17u, placement_count);
+    REQUIRE CHECK(vertical_i.direction == PieceDirection::EAST);
+    CHECK_EQUAL(0u, vertical_i.row);
+
+    CHECK_EQUAL(1u, board.place(shapes, vertical_i));
+    CHECK_EQUAL(3u, board.stackHeight());
+    CHECK_EQUAL(1u << 9, board.row(0));
+}
+
+TEST(PackBitsRoundtrip)
+{
+    std::vector<uint8_t> data;
+    for (unsigned i = 0; i < 300; i++)
+        data.push_back(0);
+    for (unsigned i = 0; i < 300; i++)
+        data.push_back(i % 7);
+    data.push_back(5);
+
+    std::vector<uint8_t> encoded;
+    PackBits::encode(data.data(), data.size(), encoded);
+    CHECK(encoded.size() < data.size());
+
+    std::vector<uint8_t> decoded;
+    CHECK(PackBits::decode(encoded.data(), encoded.size(), decoded));
+    CHECK(decoded == data);
+}
+
+TEST_FIXTURE(SelfPlayFixture, WriteGames)
+{
+    const std::string path = "test_selfplay.obsp";
+
+    Bot::SelfPlay::Settings settings;
+    settings.game_count = 4;
+    settings.thread_count = 2;
+    settings.versus = true;
+    settings.max_moves = 100;
+
+    Bot::SelfPlayStats stats;
+    uint64_t written_records;
+    {
+        Bot::DatasetWriter writer(path, 64, 2);
+        stats = Bot::SelfPlay(settings).run(writer);
+        CHECK(writer.finish());
+        written_records = writer.writtenRecords();
+    }
+    CHECK_EQUAL(4u, stats.games);
+    CHECK(stats.positions > 0);
+    CHECK_EQUAL(stats.positions, written_records);
+
+    std::ifstream file(path, std::ios::binary);
+    const std::vector<char> content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    std::remove(path.c_str());
+
+    REQUIRE CHECK(content.size() > 8);
+    CHECK_EQUAL("OBSP", std::string(content.begin(), content.begin() + 4));
+}
+
+} // Suite
@@ -0,0 +1,64 @@
+#include "UnitTest++/UnitTest++.h"
+
+#include "game/trace/TraceRecorder.h"
+#include "game/trace/TraceSummary.h"
+
+#include <cstdio>
+#include <sstream>
+
+
+SUITE(Trace) {
+
+TEST(RecordAndSummarize)
+{
+    const std::string path = "test_trace.obtr";
+    {
+        Trace::Recorder recorder(path, 4096);
+        for (unsigned frame = 0; frame < 1000; frame++) {
+            recorder.markUpdate();
+            if (frame % 10 == 0) {
+                recorder.recordInput(InputEvent(InputType::GAME_HARDDROP, true, 1));
+                recorder.recordInput(InputEvent(InputType::GAME_HARDDROP, false, 1));
+
+                WellEvent harddrop(WellEvent::Type::HARDDROPPED);
+                harddrop.harddrop.count = 18;
+                recorder.recordWellEvent(1, harddrop);
+                recorder.recordWellEvent(1, WellEvent(WellEvent::Type::PIECE_LOCKED));
+            }
+            if (frame == 500) {
+                recorder.recordGarbageQueued(1, 4);
+                recorder.recordGarbageRaised(1, 4);
+            }
+            recorder.markRender();
+        }
+        CHECK(recorder.finish());
+        CHECK_EQUAL(0u, recorder.droppedRecords());
+    }
+
+    const auto summary = Trace::Summary::fromFile(path);
+    std::remove(path.c_str());
+
+    CHECK_EQUAL(1000u + 1000u + 100u * 4u + 2u, summary.record_count);
+    CHECK_EQUAL(1000u, summary.updates);
+    CHECK_EQUAL(1000u, summary.renders);
+    CHECK_EQUAL(100u, summary.key_presses[static_cast<unsigned>(InputType::GAME_HARDDROP)]);
+    CHECK_EQUAL(100u, summary.well_events[static_cast<unsigned>(WellEvent::Type::PIECE_LOCKED)]);
+    CHECK_EQUAL(100u, summary.input_to_lock.count);
+    CHECK(summary.input_to_lock.min_ns <= summary.input_to_lock.p95_ns);
+    CHECK(summary.input_to_lock.p95_ns <= summary.input_to_lock.max_ns);
+    REQUIRE CHECK_EQUAL(2u, summary.garbage.size());
+    CHECK(!summary.garbage[0].raised);
+    CHECK(summary.garbage[1].raised);
+    CHECK_EQUAL(4u, summary.garbage[1].lines);
+
+    std::ostringstream output;
+    summary.print(output);
+    CHECK(output.str().find("hard drop") != std::string::npos);
+}
+
+TEST(InvalidFile)
+{
+    CHECK_THROW(Trace::Summary::fromFile("nonexistent.obtr"), std::runtime_error);
+}
+
+} // Suite
@@ -6,6 +6,7 @@
 #include "game/components/PieceFactory.h"
 #include "game/components/Well.h"
 #include "game/components/rotations/SRS.h"
+#include "game/util/AllocationCounter.h"
 
 
 SUITE(Well) {
@@ -51,6 +52,25 @@ TEST_FIXTURE(WellFixture, FromAscii) {
     CHECK_EQUAL(expected_ascii, well.asAscii());
 }
 
+TEST_FIXTURE(WellFixture, AddGarbageRows) {
+    std::string base_ascii;
+    for (unsigned i = 0; i < 21; i++)
+        base_ascii += emptyline_ascii;
+    base_ascii += "SSSS...ZZZ\n";
+    well.fromAscii(base_ascii);
+
+    const uint16_t rows[] = {0x3FF & ~(1 << 0), 0x3FF & ~(1 << 9)};
+    well.addGarbageRows(rows, 2);
+
+    std::string expected_ascii;
+    for (unsigned i = 0; i < 19; i++)
+        expected_ascii += emptyline_ascii;
+    expected_ascii += "SSSS...ZZZ\n";
+    expected_ascii += ".+++++++++\n";
+    expected_ascii += "+++++++++.\n";
+    CHECK_EQUAL(expected_ascii, well.asAscii());
+}
+
 TEST_FIXTURE(WellFixture, AddPiece) {
     well.addPiece(PieceType::S);
     REQUIRE CHECK(well.activePiece() != nullptr);
@@ -68,6 +88,125 @@ TEST_FIXTURE(WellFixture, AddPiece) {
     CHECK_EQUAL(expected_ascii, well.asAscii());
 }
 
+TEST_FIXTURE(WellFixture, Observers) {
+    unsigned lock_count = 0;
+    unsigned next_count = 0;
+    well.registerObserver(WellEvent::Type::PIECE_LOCKED, [&lock_count](const WellEvent& event){
+        CHECK(event.type == WellEvent::Type::PIECE_LOCKED);
+        lock_count++;
+    });
+    Well::Observer next_observer([&next_count](const WellEvent&){ next_count++; });
+    Well::Observer moved_observer(std::move(next_observer));
+    CHECK(!next_observer);
+    well.registerObserver(WellEvent::Type::NEXT_REQUESTED, std::move(moved_observer));
+
+    well.addPiece(PieceType::S);
+    unsigned frame_limit = 0;
+    while (frame_limit < 30 * gravity_delay_frames && !lock_count) {
+        well.update({});
+        well.dispatchEvents();
+        frame_limit++;
+    }
+    CHECK_EQUAL(1u, lock_count);
+    CHECK(next_count > 0);
+}
+
+TEST_FIXTURE(WellFixture, DeferredEvents) {
+    unsigned next_count = 0;
+    well.registerObserver(WellEvent::Type::NEXT_REQUESTED, [this, &next_count](const WellEvent&){
+        next_count++;
+        well.addPiece(PieceType::O);
+    });
+
+    // the request is only delivered after the update
+    well.updateGameplayOnly({});
+    CHECK_EQUAL(0u, next_count);
+    CHECK(well.activePiece() == nullptr);
+
+    CHECK_EQUAL(1u, well.dispatchEvents());
+    CHECK_EQUAL(1u, next_count);
+    REQUIRE CHECK(well.activePiece() != nullptr);
+    CHECK(well.activePiece()->type() == PieceType::O);
+
+    // nobody observes the movement events, so they are not queued
+    const std::vector<InputEvent> move_left = {InputEvent(InputType::GAME_MOVE_LEFT, true)};
+    well.updateKeystateOnly(move_left);
+    well.updateGameplayOnly(move_left);
+    CHECK_EQUAL(0u, well.dispatchEvents());
+}
+
+TEST_FIXTURE(WellFixture, SteadyStateWithoutAllocations) {
+    if (!AllocationCounter::enabled())
+        return;
+
+    // every I piece dropped at the spawn position clears a line
+    std::string base_ascii = emptyline_ascii + emptyline_ascii;
+    for (unsigned i = 2; i < 22; i++)
+        base_ascii += "SSS....ZZZ\n";
+    well.fromAscii(base_ascii);
+
+    unsigned lineclear_count = 0;
+    well.registerObserver(WellEvent::Type::LINE_CLEAR, [&lineclear_count](const WellEvent&){
+        lineclear_count++;
+    });
+    well.registerObserver(WellEvent::Type::NEXT_REQUESTED, [this](const WellEvent&){
+        well.addPiece(PieceType::I);
+    });
+
+    const std::vector<InputEvent> harddrop_press = {InputEvent(InputType::GAME_HARDDROP, true)};
+    const std::vector<InputEvent> harddrop_release = {InputEvent(InputType::GAME_HARDDROP, false)};
+    const std::vector<InputEvent> no_input;
+    auto play_frames = [&](unsigned frame_count){
+        for (unsigned frame = 0; frame < frame_count; frame++) {
+            if (!well.activePiece())
+                well.update(no_input);
+            else
+                well.update(frame % 2 ? harddrop_release : harddrop_press);
+            well.dispatchEvents();
+        }
+    };
+
+    // the first pieces and animations may allocate
+    well.addPiece(PieceType::I);
+    play_frames(120);
+    REQUIRE CHECK(lineclear_count > 0);
+
+    const unsigned lineclears_before = lineclear_count;
+    const uint64_t allocations_before = AllocationCounter::count();
+    play_frames(240);
+    CHECK_EQUAL(allocations_before, AllocationCounter::count());
+    CHECK(lineclear_count > lineclears_before);
+}
+
+TEST_FIXTURE(WellFixture, HardDropAfterLineClear) {
+    // every I piece dropped at the spawn position clears a line
+    std::string base_ascii = emptyline_ascii + emptyline_ascii;
+    for (unsigned i = 2; i < 22; i++)
+        base_ascii += "SSS....ZZZ\n";
+    well.fromAscii(base_ascii);
+
+    unsigned lineclear_count = 0;
+    well.registerObserver(WellEvent::Type::LINE_CLEAR, [&lineclear_count](const WellEvent&){
+        lineclear_count++;
+    });
+    well.registerObserver(WellEvent::Type::NEXT_REQUESTED, [this](const WellEvent&){
+        well.addPiece(PieceType::I);
+    });
+
+    // the next piece only arrives after the update, so some of the
+    // presses happen in the frames without an active piece
+    const std::vector<InputEvent> harddrop_press = {InputEvent(InputType::GAME_HARDDROP, true)};
+    well.addPiece(PieceType::I);
+    for (unsigned frame = 0; frame < 240; frame++) {
+        well.update(harddrop_press);
+        well.dispatchEvents();
+    }
+
+    // the drops pressed without a piece are done when the next one arrives
+    CHECK(lineclear_count > 2);
+    CHECK(well.activePiece() == nullptr || well.activePiece()->type() == PieceType::I);
+}
+
 TEST_FIXTURE(WellFixture, Gravity) {
     well.addPiece(PieceType::S);
     REQUIRE CHECK(well.activePiece() != nullptr);
@@ -136,6 +275,32 @@ TEST_FIXTURE(WellFixture, Gravity) {
 }
 
 
+TEST_FIXTURE(WellFixture, Gravity20G) {
+    well.setGravity(Duration::zero());
+    well.addPiece(PieceType::S);
+    well.update({});
+    REQUIRE CHECK(well.activePiece() != nullptr);
+
+    // the piece falls to the bottom in one frame
+    std::string expected_ascii;
+    for (unsigned i = 0; i < 20; i++)
+        expected_ascii += emptyline_ascii;
+    expected_ascii += "....ss....\n";
+    expected_ascii += "...ss.....\n";
+    CHECK_EQUAL(expected_ascii, well.asAscii());
+
+    // and can still slide on the ground until the lock delay runs out
+    well.update({InputEvent(InputType::GAME_MOVE_LEFT, true)});
+    well.update({InputEvent(InputType::GAME_MOVE_LEFT, false)});
+    REQUIRE CHECK(well.activePiece() != nullptr);
+    expected_ascii = "";
+    for (unsigned i = 0; i < 20; i++)
+        expected_ascii += emptyline_ascii;
+    expected_ascii += "...ss.....\n";
+    expected_ascii += "..ss......\n";
+    CHECK_EQUAL(expected_ascii, well.asAscii());
+}
+
 TEST_FIXTURE(WellFixture, MoveLeft) {
     well.addPiece(PieceType::I);
     well.update({InputEvent(InputType::GAME_MOVE_LEFT, true)});
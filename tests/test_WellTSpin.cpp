@@ -78,6 +78,7 @@ TEST_FIXTURE(WellFixture, Basic)
     }
 
     CHECK(well.activePiece() == nullptr);
+    well.dispatchEvents();
     CHECK_EQUAL(true, tspin_detected);
 }
 
@@ -135,6 +136,7 @@ TEST_FIXTURE(WellFixture, Tricky)
     }
 
     CHECK(well.activePiece() == nullptr);
+    well.dispatchEvents();
     CHECK_EQUAL(true, tspin_detected);
 }
 
@@ -181,6 +183,7 @@ TEST_FIXTURE(WellFixture, TrickyCross)
     }
 
     CHECK(well.activePiece() == nullptr);
+    well.dispatchEvents();
     CHECK_EQUAL(true, tspin_detected);
 }
 
@@ -221,6 +224,7 @@ TEST_FIXTURE(WellFixture, Mini)
     }
 
     CHECK(well.activePiece() == nullptr);
+    well.dispatchEvents();
     CHECK_EQUAL(true, tspin_detected);
 }
 
@@ -0,0 +1,35 @@
+#include "UnitTest++/UnitTest++.h"
+
+#include "game/util/WorkerPool.h"
+
+#include <atomic>
+#include <vector>
+
+
+SUITE(WorkerPool) {
+
+TEST(EveryIndexOnce)
+{
+    WorkerPool pool(3);
+    CHECK_EQUAL(3u, pool.threadCount());
+
+    std::vector<unsigned> calls(100);
+    auto task = [&calls](size_t index){ calls[index]++; };
+    for (unsigned round = 0; round < 50; round++)
+        pool.parallelFor(calls.size(), task);
+
+    for (unsigned count : calls)
+        CHECK_EQUAL(50u, count);
+}
+
+TEST(NoThreads)
+{
+    WorkerPool pool(0);
+
+    std::atomic<unsigned> sum(0);
+    auto task = [&sum](size_t index){ sum += index; };
+    pool.parallelFor(10, task);
+    CHECK_EQUAL(45u, sum.load());
+}
+
+} // Suite
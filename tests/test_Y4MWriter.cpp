@@ -0,0 +1,52 @@
+#include "UnitTest++/UnitTest++.h"
+
+#include "system/Y4MWriter.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+SUITE(Y4MWriter) {
+
+TEST(WriteFrames)
+{
+    const std::string path = "test_video.y4m";
+    {
+        const std::vector<uint32_t> red(3 * 2, 0xFFFF0000);
+        const std::vector<uint32_t> white(4 * 4, 0xFFFFFFFF);
+
+        Y4MWriter writer(path, 60);
+        writer.setFrame(red.data(), 3, 2);
+        CHECK(writer.writeFrames(2));
+        // larger frames are cropped
+        writer.setFrame(white.data(), 4, 4);
+        CHECK(writer.writeFrames());
+        CHECK_EQUAL(3u, writer.frameCount());
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+    std::remove(path.c_str());
+
+    const std::string header = "YUV4MPEG2 W3 H2 F60:1 Ip A1:1 C420jpeg XCOLORRANGE=FULL\n";
+    const std::string frame_header = "FRAME\n";
+    const size_t frame_size = 3 * 2 + 2 * (2 * 1);
+    REQUIRE CHECK_EQUAL(header.size() + 3 * (frame_header.size() + frame_size), content.size());
+    CHECK_EQUAL(header, content.substr(0, header.size()));
+
+    const size_t red_frame = header.size() + frame_header.size();
+    CHECK_EQUAL(77, static_cast<uint8_t>(content[red_frame])); // Y
+    CHECK_EQUAL(85, static_cast<uint8_t>(content[red_frame + 6])); // U
+    CHECK_EQUAL(255, static_cast<uint8_t>(content[red_frame + 8])); // V
+
+    const size_t white_frame = red_frame + 2 * (frame_header.size() + frame_size);
+    CHECK_EQUAL(255, static_cast<uint8_t>(content[white_frame]));
+    CHECK_EQUAL(128, static_cast<uint8_t>(content[white_frame + 6]));
+    CHECK_EQUAL(128, static_cast<uint8_t>(content[white_frame + 8]));
+}
+
+} // Suite